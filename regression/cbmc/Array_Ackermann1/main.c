@@ -0,0 +1,24 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned i=nondet_unsigned();
+  unsigned j=nondet_unsigned();
+  __CPROVER_assume(i<100 && j<100);
+
+  int a[200];
+
+  a[i]=1;
+  a[i+1]=2;
+  a[i+2]=3;
+  a[i-1]=4;
+  a[0]=5;
+
+  // i+1 and i+2 are never equal, but j may be either
+  __CPROVER_assert(a[i+1]==2, "holds");
+  __CPROVER_assert(a[i+2]==3, "holds");
+  __CPROVER_assert(a[j]!=3, "fails for j=i+2");
+  __CPROVER_assert(i!=1 || a[0]==5, "holds");
+
+  return 0;
+}
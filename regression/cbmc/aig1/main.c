@@ -0,0 +1,18 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y=nondet_unsigned();
+
+  // the same circuits, built twice
+  unsigned a=(x^y)&(x|y);
+  unsigned b=(x^y)&(x|y);
+  __CPROVER_assert(a==b, "shared");
+
+  __CPROVER_assert((x&y)+(x|y)==x+y, "sum");
+  __CPROVER_assert((x&~x)==0, "contradiction");
+  __CPROVER_assert(x+y!=10 || x!=3, "fails for y=7");
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+unsigned nondet_unsigned();
+_Bool nondet_bool();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y;
+
+  if(nondet_bool())
+    y=x*3;
+  else
+    y=x+5;
+
+  if(x<100)
+    __CPROVER_assert(y!=8, "reachable with x=3 on the second branch");
+
+  __CPROVER_assert(x<100 || y!=0 || x%3==0 || x+5==0,
+                   "holds in every cube");
+
+  return 0;
+}
@@ -0,0 +1,11 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y=x*x+1;
+
+  __CPROVER_assert(y!=0, "no overflow to zero");
+
+  return 0;
+}
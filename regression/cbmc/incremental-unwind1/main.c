@@ -0,0 +1,12 @@
+int main()
+{
+  int x=0;
+
+  for(int i=0; i<10; i++)
+    x+=2;
+
+  // fails only once the loop has been unwound 10 times
+  __CPROVER_assert(x!=20, "property");
+
+  return 0;
+}
@@ -0,0 +1,13 @@
+int main()
+{
+  unsigned n;
+  __CPROVER_assume(n<=5);
+
+  int sum=0;
+  for(unsigned i=0; i<n; i++)
+    sum+=i;
+
+  __CPROVER_assert(sum<=10, "property");
+
+  return 0;
+}
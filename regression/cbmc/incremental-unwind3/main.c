@@ -0,0 +1,12 @@
+int main()
+{
+  unsigned n;
+  int x=0;
+
+  for(unsigned i=0; i<n; i++)
+    x++;
+
+  __CPROVER_assert(x>=0, "property");
+
+  return 0;
+}
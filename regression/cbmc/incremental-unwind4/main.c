@@ -0,0 +1,25 @@
+#include <stdlib.h>
+
+unsigned nondet_unsigned();
+
+int main()
+{
+  int *p=malloc(sizeof(int));
+  *p=1;
+
+  unsigned n=nondet_unsigned();
+  __CPROVER_assume(n<=3);
+
+  int x=0;
+
+  for(unsigned i=0; i<n; i++)
+  {
+    // with small bounds, the increment is sliced away, but is needed
+    // with larger bounds
+    __CPROVER_assert(x<5, "x is small");
+    __CPROVER_assert(*p==1, "dynamic object is unchanged");
+    x++;
+  }
+
+  return 0;
+}
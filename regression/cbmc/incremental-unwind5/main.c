@@ -0,0 +1,17 @@
+int x;
+
+void set(void)
+{
+  x=1;
+}
+
+int main()
+{
+__CPROVER_ASYNC_1:
+  set();
+
+  for(int i=0; i<2; i++)
+    __CPROVER_assert(x==0 || x==1, "x is 0 or 1");
+
+  return 0;
+}
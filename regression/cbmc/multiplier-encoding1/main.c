@@ -0,0 +1,14 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y=nondet_unsigned();
+
+  __CPROVER_assert(x*y==y*x, "commutative");
+  __CPROVER_assert(x*7==(x<<3)-x, "constant");
+  __CPROVER_assert(x/8==x>>3, "power of two");
+  __CPROVER_assert(x*y!=6, "fails for x*y=6");
+
+  return 0;
+}
@@ -0,0 +1,17 @@
+int main()
+{
+  int a, b, c;
+  int x=0;
+
+  if(a)
+    x+=1;
+  if(b)
+    x+=2;
+  if(c)
+    x+=4;
+
+  __CPROVER_assert(x!=7, "all branches taken");
+  __CPROVER_assert(x<8, "bounded");
+
+  return 0;
+}
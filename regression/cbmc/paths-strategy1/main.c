@@ -0,0 +1,17 @@
+int main()
+{
+  int a, b;
+  int x=0;
+
+  if(a)
+    x=1;
+  else
+    x=2;
+
+  if(b)
+    x+=10;
+
+  __CPROVER_assert(x!=12, "reachable on one path only");
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y=nondet_unsigned();
+
+  __CPROVER_assert(x*y==y*x, "commutative");
+  __CPROVER_assert(x+y!=10 || x!=3, "fails for y=7");
+
+  return 0;
+}
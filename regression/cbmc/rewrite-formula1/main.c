@@ -0,0 +1,16 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned c=3;
+  unsigned y=x*x;
+  unsigned z=x*x;
+  unsigned w=y;
+
+  __CPROVER_assert(w==z, "common subterm");
+  __CPROVER_assert(c*x==x+x+x, "constant");
+  __CPROVER_assert(y!=4, "fails for x=2");
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+int main()
+{
+  int a, b, c, d;
+
+  // each worker only needs the assignments its own properties read
+  int a2=a*a;
+  int b2=b*b;
+  int c2=c+1;
+
+  // but every worker has to keep the assumptions
+  __CPROVER_assume(d>10);
+  int d2=d-10;
+
+  assert(a2>=0 || a<0 || a>46340);
+  assert(b2!=2);
+  assert(c2!=c);
+  assert(c2!=5);
+  assert(d2>0);
+
+  return 0;
+}
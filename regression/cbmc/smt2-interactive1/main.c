@@ -0,0 +1,16 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int a[4];
+
+  for(int i=0; i<4; i++)
+    a[i]=x+i;
+
+  __CPROVER_assume(x>10);
+  __CPROVER_assert(a[3]!=17, "reachable");
+  __CPROVER_assert(a[0]>10, "holds");
+
+  return 0;
+}
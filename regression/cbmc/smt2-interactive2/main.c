@@ -0,0 +1,11 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+
+  __CPROVER_assume(x>10);
+  __CPROVER_assert(x!=17, "reachable");
+
+  return 0;
+}
@@ -0,0 +1,33 @@
+#include <assert.h>
+
+int f(int x)
+{
+  if(x>=10)
+    assert(x>=5);
+
+  assert(x>=5); // unknown, as nothing is known about x
+
+  return x;
+}
+
+int g(int y)
+{
+  int z=y;
+
+  if(z<0)
+    z=0;
+
+  assert(z>=0);
+
+  return z;
+}
+
+int main()
+{
+  int a=f(20);
+  int b=g(a);
+
+  assert(b>=0); // unknown, as the calls are not followed
+
+  return 0;
+}
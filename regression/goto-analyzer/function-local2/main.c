@@ -0,0 +1,30 @@
+#include <assert.h>
+
+int g;
+
+void set_global(void)
+{
+  g=1;
+}
+
+void set(int *p)
+{
+  *p=1;
+}
+
+int main()
+{
+  g=0;
+  set_global();
+  assert(g==0); // unknown, the call may write the global
+
+  int x=0;
+  set(&x);
+  assert(x==0); // unknown, the call may write the address-taken local
+
+  int y=0;
+  set_global();
+  assert(y==0);
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include <assert.h>
+
+int r;
+
+void inc(int x)
+{
+  r=x+1;
+}
+
+int main()
+{
+  r=0;
+  inc(1);
+  assert(r==2);
+
+  r=0;
+  inc(10);
+  assert(r==11);
+
+  // the same entry state as the first call, which reuses its summary
+  r=0;
+  inc(1);
+  assert(r==2);
+
+  return 0;
+}
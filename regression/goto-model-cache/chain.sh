@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+
+# Runs cbmc twice on the same goto binary with a fresh cache directory.
+# Only the output of the second run, which should read the cached goto
+# model, is checked.
+
+goto_cc=$1
+cbmc=$2
+is_windows=$3
+
+options=${*:4:$#-4}
+name=${*:$#}
+name=${name%.c}
+
+if [[ "${is_windows}" == "true" ]]; then
+  "${goto_cc}" "${name}.c"
+  mv "${name}.exe" "${name}.gb"
+else
+  "${goto_cc}" "${name}.c" -o "${name}.gb"
+fi
+
+cache_dir=$(mktemp -d)
+
+"${cbmc}" "${name}.gb" --goto-model-cache "${cache_dir}" ${options} \
+  > /dev/null 2>&1
+"${cbmc}" "${name}.gb" --goto-model-cache "${cache_dir}" ${options}
+result=$?
+
+rm -rf "${cache_dir}"
+exit ${result}
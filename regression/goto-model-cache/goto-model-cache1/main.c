@@ -0,0 +1,13 @@
+#include <assert.h>
+
+int main()
+{
+  int a[4];
+
+  for(int i=0; i<4; i++)
+    a[i]=i;
+
+  assert(a[3]==4);
+
+  return 0;
+}
@@ -332,7 +332,7 @@ bool ai_baset::visit(
 {
   bool new_data=false;
 
-  statet &current=get_state(l);
+  statet &current=current_state(l);
 
   for(const auto &to_l : goto_program.get_successors(l))
   {
@@ -363,11 +363,11 @@ bool ai_baset::visit(
     else
     {
       // initialize state, if necessary
-      get_state(to_l);
+      current_state(to_l);
 
       new_values.transform(l, to_l, *this, ns);
 
-      if(merge(new_values, l, to_l))
+      if(merge_current(new_values, l, to_l))
         have_new_values=true;
     }
 
@@ -389,7 +389,7 @@ bool ai_baset::do_function_call(
   const namespacet &ns)
 {
   // initialize state, if necessary
-  get_state(l_return);
+  current_state(l_return);
 
   const goto_functionst::goto_functiont &goto_function=
     f_it->second;
@@ -397,10 +397,11 @@ bool ai_baset::do_function_call(
   if(!goto_function.body_available())
   {
     // if we don't have a body, we just do an edige call -> return
-    std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
+    std::unique_ptr<statet> tmp_state(
+      make_temporary_state(current_state(l_call)));
     tmp_state->transform(l_call, l_return, *this, ns);
 
-    return merge(*tmp_state, l_call, l_return);
+    return merge_current(*tmp_state, l_call, l_return);
   }
 
   assert(!goto_function.body.instructions.empty());
@@ -411,16 +412,17 @@ bool ai_baset::do_function_call(
     // get the state at the beginning of the function
     locationt l_begin=goto_function.body.instructions.begin();
     // initialize state, if necessary
-    get_state(l_begin);
+    current_state(l_begin);
 
     // do the edge from the call site to the beginning of the function
-    std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
+    std::unique_ptr<statet> tmp_state(
+      make_temporary_state(current_state(l_call)));
     tmp_state->transform(l_call, l_begin, *this, ns);
 
     bool new_data=false;
 
     // merge the new stuff
-    if(merge(*tmp_state, l_call, l_begin))
+    if(merge_current(*tmp_state, l_call, l_begin))
       new_data=true;
 
     // do we need to do/re-do the fixedpoint of the body?
@@ -436,7 +438,7 @@ bool ai_baset::do_function_call(
     assert(l_end->is_end_function());
 
     // do edge from end of function to instruction after call
-    const statet &end_state=get_state(l_end);
+    const statet &end_state=current_state(l_end);
 
     if(end_state.is_bottom())
       return false; // function exit point not reachable
@@ -445,8 +447,151 @@ bool ai_baset::do_function_call(
     tmp_state->transform(l_end, l_return, *this, ns);
 
     // Propagate those
-    return merge(*tmp_state, l_end, l_return);
+    return merge_current(*tmp_state, l_end, l_return);
+  }
+}
+
+ai_baset::statet &ai_baset::current_state(locationt l)
+{
+  if(context_states==nullptr)
+    return get_state(l);
+
+  std::unique_ptr<statet> &state=(*context_states)[l];
+
+  if(state==nullptr)
+  {
+    state=make_temporary_state(get_state(l));
+    state->make_bottom();
   }
+
+  return *state;
+}
+
+bool ai_baset::merge_current(const statet &src, locationt from, locationt to)
+{
+  if(context_states==nullptr)
+    return merge(src, from, to);
+
+  return merge_state(current_state(to), src, from, to);
+}
+
+bool ai_baset::covers(const statet &a, const statet &b, locationt l)
+{
+  std::unique_ptr<statet> tmp_state(make_temporary_state(a));
+  return !merge_state(*tmp_state, b, l, l);
+}
+
+/// Analyses \p body, and the functions it calls, starting from the entry
+/// state of \p summary, with states of its own, and sets the exit state of
+/// \p summary. Afterwards, these states are merged into the states that
+/// the analysis reports, which therefore hold for all contexts.
+void ai_baset::compute_summary(
+  summaryt &summary,
+  const goto_programt &body,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  const locationt l_begin=body.instructions.begin();
+  const locationt l_end=std::prev(body.instructions.end());
+
+  context_statest states;
+  context_statest *const caller_states=context_states;
+  context_states=&states;
+
+  merge_current(*summary.entry, l_begin, l_begin);
+  fixedpoint(body, goto_functions, ns);
+  summary.exit=make_temporary_state(current_state(l_end));
+
+  context_states=caller_states;
+
+  for(const auto &state : states)
+    merge(*state.second, state.first, state.first);
+
+  summary_statistics.computed++;
+}
+
+bool ai_baset::do_function_call_summary(
+  locationt l_call, locationt l_return,
+  const goto_functionst &goto_functions,
+  const goto_functionst::function_mapt::const_iterator f_it,
+  const exprt::operandst &arguments,
+  const namespacet &ns)
+{
+  const goto_programt &body=f_it->second.body;
+  const locationt l_begin=body.instructions.begin();
+  const locationt l_end=std::prev(body.instructions.end());
+  assert(l_end->is_end_function());
+
+  // the state at the beginning of the function for this call
+  std::unique_ptr<statet> entry(make_temporary_state(current_state(l_call)));
+  entry->transform(l_call, l_begin, *this, ns);
+
+  if(entry->is_bottom())
+    return false; // call site not reachable
+
+  function_summariest &summaries=function_summaries[f_it->first];
+  summaryt *summary=nullptr;
+
+  for(auto &context : summaries.contexts)
+  {
+    if(covers(*context.entry, *entry, l_begin) &&
+       covers(*entry, *context.entry, l_begin))
+    {
+      summary=&context;
+      break;
+    }
+  }
+
+  if(summary==nullptr &&
+     summaries.contexts.size()<max_summary_contexts)
+  {
+    summaries.contexts.emplace_back();
+    summary=&summaries.contexts.back();
+    summary->entry=std::move(entry);
+    compute_summary(*summary, body, goto_functions, ns);
+  }
+  else if(summary==nullptr)
+  {
+    // too many contexts: fall back to one summary for all further calls,
+    // which is computed again whenever its entry state grows
+    summary=&summaries.joined;
+
+    if(summary->entry==nullptr)
+    {
+      summary->entry=std::move(entry);
+      compute_summary(*summary, body, goto_functions, ns);
+    }
+    else if(summary->exit!=nullptr &&
+            !covers(*summary->entry, *entry, l_begin))
+    {
+      merge_state(*summary->entry, *entry, l_begin, l_begin);
+      summary->exit=nullptr;
+      compute_summary(*summary, body, goto_functions, ns);
+    }
+    else if(summary->exit!=nullptr)
+      summary_statistics.reused++;
+  }
+  else if(summary->exit!=nullptr)
+    summary_statistics.reused++;
+
+  if(summary->exit==nullptr)
+  {
+    // A recursive call while the summary is computed, which is therefore
+    // analysed like a call without summaries, within the states of the
+    // outer call
+    summary_statistics.recursive++;
+    return do_function_call(
+      l_call, l_return, goto_functions, f_it, arguments, ns);
+  }
+
+  // do edge from end of function to instruction after call
+  if(summary->exit->is_bottom())
+    return false; // function exit point not reachable
+
+  std::unique_ptr<statet> tmp_state(make_temporary_state(*summary->exit));
+  tmp_state->transform(l_end, l_return, *this, ns);
+
+  return merge_current(*tmp_state, l_end, l_return);
 }
 
 bool ai_baset::do_function_call_rec(
@@ -470,12 +615,20 @@ bool ai_baset::do_function_call_rec(
     if(it==goto_functions.function_map.end())
       throw "failed to find function "+id2string(identifier);
 
-    new_data=do_function_call(
-      l_call, l_return,
-      goto_functions,
-      it,
-      arguments,
-      ns);
+    if(max_summary_contexts>0 && it->second.body_available())
+      new_data=do_function_call_summary(
+        l_call, l_return,
+        goto_functions,
+        it,
+        arguments,
+        ns);
+    else
+      new_data=do_function_call(
+        l_call, l_return,
+        goto_functions,
+        it,
+        arguments,
+        ns);
   }
   else if(function.id()==ID_if)
   {
@@ -534,6 +687,24 @@ void ai_baset::sequential_fixedpoint(
     fixedpoint(f_it->second.body, goto_functions, ns);
 }
 
+void ai_baset::function_local_fixedpoint(
+  const goto_functionst &goto_functions,
+  const namespacet &ns,
+  const std::function<bool(const irep_idt &)> &analyze_function)
+{
+  // without any functions to enter, fixedpoint() does not follow calls
+  goto_functionst no_functions;
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(f_it->second.body_available() && analyze_function(f_it->first))
+    {
+      entry_state(f_it->second.body);
+      fixedpoint(f_it->second.body, no_functions, ns);
+    }
+  }
+}
+
 void ai_baset::concurrent_fixedpoint(
   const goto_functionst &goto_functions,
   const namespacet &ns)
@@ -12,9 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_AI_H
 #define CPROVER_ANALYSES_AI_H
 
+#include <functional>
 #include <iosfwd>
+#include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include <util/json.h>
 #include <util/xml.h>
@@ -131,7 +134,9 @@ public:
   typedef ai_domain_baset statet;
   typedef goto_programt::const_targett locationt;
 
-  ai_baset()
+  ai_baset():
+    max_summary_contexts(0),
+    context_states(nullptr)
   {
   }
 
@@ -180,6 +185,22 @@ public:
     finalize();
   }
 
+  /// Analyses each function in \p goto_functions for which
+  /// \p analyze_function holds on its own, starting from the entry state at
+  /// its beginning. Calls are treated like calls to functions without body,
+  /// hence the functions can be analysed in any order, or in different
+  /// processes.
+  void function_local(
+    const goto_functionst &goto_functions,
+    const namespacet &ns,
+    const std::function<bool(const irep_idt &)> &analyze_function=
+      [](const irep_idt &) { return true; })
+  {
+    initialize(goto_functions);
+    function_local_fixedpoint(goto_functions, ns, analyze_function);
+    finalize();
+  }
+
   /// Returns the abstract state before the given instruction
   virtual const ai_domain_baset & abstract_state_before(
     goto_programt::const_targett t) const = 0;
@@ -193,6 +214,43 @@ public:
 
   virtual void clear()
   {
+    function_summaries.clear();
+    summary_statistics=summary_statisticst();
+  }
+
+  /// Makes a call reuse the effect of the function on an abstract entry
+  /// state (a summary) computed for an earlier call with the same entry
+  /// state, instead of merging all calls at the beginning of the function
+  /// and analysing its body again. Up to \p max_contexts entry states are
+  /// told apart for each function; all further calls of the function share
+  /// one summary for the join of their entry states. 0, the default,
+  /// disables summaries. Summaries need domains whose transformers only
+  /// access the states they are applied to.
+  void set_summaries(std::size_t max_contexts)
+  {
+    max_summary_contexts=max_contexts;
+  }
+
+  struct summary_statisticst
+  {
+    summary_statisticst():
+      computed(0),
+      reused(0),
+      recursive(0)
+    {
+    }
+
+    /// summaries computed by analysing the function body
+    std::size_t computed;
+    /// calls whose effect was taken from an existing summary
+    std::size_t reused;
+    /// recursive calls, analysed within the summary of the outer call
+    std::size_t recursive;
+  };
+
+  const summary_statisticst &get_summary_statistics() const
+  {
+    return summary_statistics;
   }
 
   virtual void output(
@@ -331,6 +389,10 @@ protected:
   void sequential_fixedpoint(
     const goto_functionst &goto_functions,
     const namespacet &ns);
+  void function_local_fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns,
+    const std::function<bool(const irep_idt &)> &analyze_function);
   void concurrent_fixedpoint(
     const goto_functionst &goto_functions,
     const namespacet &ns);
@@ -358,9 +420,69 @@ protected:
     const exprt::operandst &arguments,
     const namespacet &ns);
 
+  // function summaries, see set_summaries()
+  typedef std::unordered_map<
+    locationt,
+    std::unique_ptr<statet>,
+    const_target_hash,
+    pointee_address_equalt>
+    context_statest;
+
+  struct summaryt
+  {
+    std::unique_ptr<statet> entry;
+    /// nullptr while the summary is computed
+    std::unique_ptr<statet> exit;
+  };
+
+  struct function_summariest
+  {
+    /// one for each entry state that is told apart
+    std::list<summaryt> contexts;
+    /// for the join of the entry states of all further calls
+    summaryt joined;
+  };
+
+  std::size_t max_summary_contexts;
+  std::map<irep_idt, function_summariest> function_summaries;
+  summary_statisticst summary_statistics;
+
+  /// The states of the calling context that is analysed for a summary, or
+  /// nullptr if no summary is being computed
+  context_statest *context_states;
+
+  /// \return the state at \p l in the context that is being analysed
+  statet &current_state(locationt l);
+
+  /// Merges \p src into the state at \p to in the context that is being
+  /// analysed
+  bool merge_current(const statet &src, locationt from, locationt to);
+
+  /// \return true if \p a is at least as large as \p b
+  bool covers(const statet &a, const statet &b, locationt l);
+
+  void compute_summary(
+    summaryt &summary,
+    const goto_programt &body,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  bool do_function_call_summary(
+    locationt l_call, locationt l_return,
+    const goto_functionst &goto_functions,
+    const goto_functionst::function_mapt::const_iterator f_it,
+    const exprt::operandst &arguments,
+    const namespacet &ns);
+
   // abstract methods
 
   virtual bool merge(const statet &src, locationt from, locationt to)=0;
+  // merges into a state that is not stored
+  virtual bool merge_state(
+    statet &dest,
+    const statet &src,
+    locationt from,
+    locationt to)=0;
   // for concurrent fixedpoint
   virtual bool merge_shared(
     const statet &src,
@@ -443,6 +565,16 @@ protected:
       static_cast<const domainT &>(src), from, to);
   }
 
+  bool merge_state(
+    statet &dest,
+    const statet &src,
+    locationt from,
+    locationt to) override
+  {
+    return static_cast<domainT &>(dest).merge(
+      static_cast<const domainT &>(src), from, to);
+  }
+
   std::unique_ptr<statet> make_temporary_state(const statet &s) override
   {
     return util_make_unique<domainT>(static_cast<const domainT &>(s));
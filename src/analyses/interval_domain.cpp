@@ -103,6 +103,11 @@ void interval_domaint::transform(
         to_code_function_call(instruction.code);
       if(code_function_call.lhs().is_not_nil())
         havoc_rec(code_function_call.lhs());
+
+      // the callee is not analysed, e.g., as it has no body or with
+      // ai_baset::function_local, and may write any object it can reach
+      if(from->function==to->function)
+        havoc_outliving_call(ai, ns);
     }
     break;
 
@@ -210,6 +215,41 @@ void interval_domaint::havoc_rec(const exprt &lhs)
   }
 }
 
+/// Forgets the intervals of the global variables and, with interval_ait, of
+/// the local variables whose address is taken
+void interval_domaint::havoc_outliving_call(
+  const ai_baset &ai,
+  const namespacet &ns)
+{
+  const interval_ait *interval_ai=dynamic_cast<const interval_ait *>(&ai);
+
+  const auto outlives_call=[&](const irep_idt &identifier)
+  {
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol))
+      return true;
+
+    return !symbol->is_procedure_local() ||
+           (interval_ai!=nullptr && interval_ai->dirty(identifier));
+  };
+
+  for(auto it=int_map.begin(); it!=int_map.end(); )
+  {
+    if(outlives_call(it->first))
+      it=int_map.erase(it);
+    else
+      ++it;
+  }
+
+  for(auto it=float_map.begin(); it!=float_map.end(); )
+  {
+    if(outlives_call(it->first))
+      it=float_map.erase(it);
+    else
+      ++it;
+  }
+}
+
 void interval_domaint::assume_rec(
   const exprt &lhs, irep_idt id, const exprt &rhs)
 {
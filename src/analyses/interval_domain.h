@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/mp_arith.h>
 
 #include "ai.h"
+#include "dirty.h"
 #include "interval_template.h"
 
 typedef interval_templatet<mp_integer> integer_intervalt;
@@ -118,6 +119,7 @@ protected:
   float_mapt float_map;
 
   void havoc_rec(const exprt &);
+  void havoc_outliving_call(const ai_baset &ai, const namespacet &ns);
   void assume_rec(const exprt &, bool negation=false);
   void assume_rec(const exprt &lhs, irep_idt id, const exprt &rhs);
   void assign(const class code_assignt &assignment);
@@ -125,4 +127,18 @@ protected:
   ieee_float_intervalt get_float_rec(const exprt &);
 };
 
+/// Interval analysis that knows the local variables whose address is taken,
+/// which a call that is not followed into the callee may write to. With
+/// ait<interval_domaint>, such calls only havoc the global variables.
+class interval_ait:public ait<interval_domaint>
+{
+public:
+  explicit interval_ait(const goto_functionst &goto_functions):
+    dirty(goto_functions)
+  {
+  }
+
+  dirtyt dirty;
+};
+
 #endif // CPROVER_ANALYSES_INTERVAL_DOMAIN_H
@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <chrono>
 
+#include <util/forked_tasks.h>
+#include <util/make_unique.h>
 #include <util/xml.h>
 #include <util/json.h>
 
@@ -20,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/prop/literal_expr.h>
 
 #include <goto-symex/build_goto_trace.h>
+#include <goto-symex/ssa_def_use_graph.h>
 #include <goto-programs/xml_goto_trace.h>
 #include <goto-programs/json_goto_trace.h>
 
@@ -59,8 +62,6 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
 
   auto solver_start=std::chrono::steady_clock::now();
 
-  bmc.do_conversion();
-
   // Collect _all_ goals in `goal_map'.
   // This maps property IDs to 'goalt'
   forall_goto_functions(f_it, goto_functions)
@@ -87,7 +88,7 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
         property_id=id2string(
           it->source.pc->source_location.get_function())+".unwind."+
           std::to_string(it->source.pc->loop_number);
-        goal_map[property_id].description=it->comment;
+        goal_map[property_id].description=id2string(it->comment);
       }
       else
         continue;
@@ -96,6 +97,25 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
     }
   }
 
+  const unsigned jobs=bmc.options.get_unsigned_int_option("jobs");
+  // workers must not share the solver, so this needs separate processes
+  const bool use_workers=
+    jobs>1 && goal_map.size()>1 && forked_tasks_supported();
+
+  // with --slice-formula, each worker converts only what its goals
+  // depend on, and hence has to run before the conversion in here
+  const bool slice_per_worker=
+    use_workers &&
+    bmc.options.get_bool_option("slice-formula") &&
+    !bmc.equation.has_threads();
+
+  worker_answerst answers;
+
+  if(slice_per_worker)
+    answers=solve_in_workers(jobs, true);
+
+  bmc.do_conversion();
+
   do_before_solving();
 
   cover_goalst cover_goals(solver);
@@ -115,6 +135,14 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
 
   bool error=false;
 
+  if(use_workers)
+  {
+    if(!slice_per_worker)
+      answers=solve_in_workers(jobs, false);
+
+    error=apply_worker_answers(answers, cover_goals);
+  }
+
   decision_proceduret::resultt result=cover_goals();
 
   if(result==decision_proceduret::resultt::D_ERROR)
@@ -155,6 +183,136 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
   return safe?safety_checkert::resultt::SAFE:safety_checkert::resultt::UNSAFE;
 }
 
+/// Partitions the goals over up to \p jobs worker processes, each of which
+/// solves its share of the goals incrementally. Without \p slice, the
+/// workers inherit a copy of the solver with the formula already converted.
+/// With \p slice, each worker marks the steps that its goals do not depend
+/// on as ignored and then converts the formula itself, which requires that
+/// the formula has not been converted yet.
+/// \return the answer of each worker, one character per goal: 'F'ailed,
+///   'S'uccess or 'E'rror
+bmc_all_propertiest::worker_answerst bmc_all_propertiest::solve_in_workers(
+  unsigned jobs,
+  bool slice)
+{
+  std::vector<goal_mapt::iterator> goals;
+
+  for(goal_mapt::iterator g_it=goal_map.begin();
+      g_it!=goal_map.end();
+      g_it++)
+    goals.push_back(g_it);
+
+  const std::size_t number_of_workers=
+    std::min(goals.size(), static_cast<std::size_t>(jobs));
+
+  status() << "Checking " << goals.size() << " properties in "
+           << number_of_workers << " worker processes" << eom;
+
+  // built once, and inherited by the workers
+  std::unique_ptr<ssa_def_use_grapht> def_use_graph;
+
+  if(slice)
+    def_use_graph=util_make_unique<ssa_def_use_grapht>(bmc.equation);
+
+  // goal i is handled by worker i%number_of_workers
+  auto worker=[&](std::size_t worker_number)
+  {
+    null_message_handlert null_message_handler;
+    solver.set_message_handler(null_message_handler);
+
+    if(slice)
+    {
+      bmc.set_message_handler(null_message_handler);
+
+      ssa_def_use_grapht::stepst properties;
+
+      for(std::size_t i=worker_number; i<goals.size(); i+=number_of_workers)
+      {
+        const goalt::instancest &instances=goals[i]->second.instances;
+        properties.insert(properties.end(), instances.begin(), instances.end());
+      }
+
+      def_use_graph->slice(properties);
+      bmc.do_conversion();
+    }
+
+    cover_goalst worker_goals(solver);
+    worker_goals.set_message_handler(null_message_handler);
+
+    for(std::size_t i=worker_number; i<goals.size(); i+=number_of_workers)
+      worker_goals.add(!solver.convert(goals[i]->second.as_expr()));
+
+    const decision_proceduret::resultt result=worker_goals();
+
+    std::string answer;
+    for(const auto &goal : worker_goals.goals)
+    {
+      if(goal.status==cover_goalst::goalt::statust::COVERED)
+        answer+='F';
+      else if(result==decision_proceduret::resultt::D_UNSATISFIABLE)
+        answer+='S';
+      else
+        answer+='E';
+    }
+
+    return answer;
+  };
+
+  return run_forked_tasks(number_of_workers, jobs, worker);
+}
+
+/// Marks the goals that the workers found to hold as such in both
+/// `goal_map` and \p cover_goals. Goals found to fail are left unknown, so
+/// that the subsequent (cheap, satisfiable) run of \p cover_goals in this
+/// process builds their traces. This keeps traces deterministic and avoids
+/// passing them between processes.
+/// \return true if some worker failed to decide some of its goals
+bool bmc_all_propertiest::apply_worker_answers(
+  const worker_answerst &answers,
+  cover_goalst &cover_goals)
+{
+  std::vector<goal_mapt::iterator> goals;
+  std::vector<cover_goalst::goalst::iterator> conditions;
+
+  cover_goalst::goalst::iterator c_it=cover_goals.goals.begin();
+  for(goal_mapt::iterator g_it=goal_map.begin();
+      g_it!=goal_map.end();
+      g_it++, c_it++)
+  {
+    goals.push_back(g_it);
+    conditions.push_back(c_it);
+  }
+
+  const std::size_t number_of_workers=answers.size();
+  bool error=false;
+
+  for(std::size_t w=0; w<number_of_workers; w++)
+  {
+    // a worker that did not terminate normally has decided nothing
+    const std::string answer_string=answers[w].value_or(std::string());
+    std::size_t k=0;
+
+    for(std::size_t i=w; i<goals.size(); i+=number_of_workers, k++)
+    {
+      const char answer=k<answer_string.size()?answer_string[k]:'E';
+
+      if(answer=='S')
+      {
+        goals[i]->second.status=goalt::statust::SUCCESS;
+        conditions[i]->status=cover_goalst::goalt::statust::UNCOVERED;
+      }
+      else if(answer!='F')
+      {
+        error=true;
+        goals[i]->second.status=goalt::statust::ERROR;
+        conditions[i]->status=cover_goalst::goalt::statust::ERROR;
+      }
+    }
+  }
+
+  return error;
+}
+
 void bmc_all_propertiest::report(const cover_goalst &cover_goals)
 {
   switch(bmc.ui)
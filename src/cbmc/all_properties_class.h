@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_ALL_PROPERTIES_CLASS_H
 #define CPROVER_CBMC_ALL_PROPERTIES_CLASS_H
 
+#include <util/optional.h>
+
 #include <solvers/prop/cover_goals.h>
 
 #include "bmc.h"
@@ -91,6 +93,12 @@ protected:
 
   virtual void report(const cover_goalst &cover_goals);
   virtual void do_before_solving() {}
+
+  typedef std::vector<optionalt<std::string>> worker_answerst;
+  worker_answerst solve_in_workers(unsigned jobs, bool slice);
+  bool apply_worker_answers(
+    const worker_answerst &answers,
+    cover_goalst &cover_goals);
 };
 
 #endif // CPROVER_CBMC_ALL_PROPERTIES_CLASS_H
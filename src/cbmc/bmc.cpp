@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <memory>
 
 #include <util/exit_codes.h>
+#include <util/forked_tasks.h>
 #include <util/string2int.h>
 #include <util/source_location.h>
 #include <util/string_utils.h>
@@ -35,12 +36,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/graphml_witness.h>
 
 #include <goto-symex/build_goto_trace.h>
+#include <goto-symex/rewrite_equation.h>
 #include <goto-symex/slice.h>
 #include <goto-symex/slice_by_trace.h>
 #include <goto-symex/memory_model_sc.h>
 #include <goto-symex/memory_model_tso.h>
 #include <goto-symex/memory_model_pso.h>
 
+#include "bmc_incremental.h"
+#include "bv_cbmc.h"
 #include "cbmc_solvers.h"
 #include "counterexample_beautification.h"
 #include "fault_localization.h"
@@ -127,6 +131,22 @@ void bmct::output_graphml(resultt result)
   }
 }
 
+/// \return the conditions of the branches that are not nested in other
+///   branches, in the order symex took them
+static bvt top_level_branch_literals(const symex_target_equationt &equation)
+{
+  bvt result;
+
+  for(const auto &step : equation.SSA_steps)
+    if(step.is_goto() &&
+       !step.ignore &&
+       step.guard_literal.is_true() &&
+       !step.cond_literal.is_constant())
+      result.push_back(step.cond_literal);
+
+  return result;
+}
+
 void bmct::do_conversion()
 {
   // convert HDL (hook for hw-cbmc)
@@ -145,6 +165,17 @@ void bmct::do_conversion()
     for(const auto &constraint : bmc_constraints)
       prop_conv.set_to_true(constraint);
   }
+
+  // the top-level branches decide over most of the formula, and make good
+  // cubes
+  if(options.get_bool_option("cube-and-conquer"))
+  {
+    auto bv_cbmc=dynamic_cast<bv_cbmct *>(&prop_conv);
+
+    if(bv_cbmc!=nullptr)
+      bv_cbmc->set_split_literals(top_level_branch_literals(equation));
+  }
+
   // hook for cegis to freeze synthesis program vars
   freeze_program_variables();
 }
@@ -172,6 +203,10 @@ bmct::run_decision_procedure(prop_convt &prop_conv)
              << "s" << eom;
   }
 
+  debug() << "Memory consumption:" << messaget::endl;
+  memory_info(debug());
+  debug() << eom;
+
   return dec_result;
 }
 
@@ -361,8 +396,22 @@ safety_checkert::resultt bmct::execute(const goto_functionst &goto_functions)
 {
   try
   {
+    auto symex_start = std::chrono::steady_clock::now();
+
     perform_symbolic_execution(goto_functions);
 
+    {
+      auto symex_stop = std::chrono::steady_clock::now();
+      statistics() << "Runtime Symex: "
+                   << std::chrono::duration<double>(symex_stop-symex_start)
+                        .count()
+                   << "s" << eom;
+    }
+
+    // let the path strategy know what this path has done
+    if(options.get_bool_option("paths"))
+      path_storage.path_explored(equation);
+
     // add a partial ordering, if required
     if(equation.has_threads())
     {
@@ -485,6 +534,17 @@ void bmct::slice()
       }
     }
   }
+  if(options.get_bool_option("rewrite-formula"))
+  {
+    const rewrite_equation_statisticst rewritten=
+      rewrite_equation(equation, ns);
+    statistics() << "rewriting propagated "
+                 << rewritten.constants << " constants, "
+                 << rewritten.copies << " copies and "
+                 << rewritten.common_subterms << " common subterms into "
+                 << rewritten.rewritten_steps << " steps" << eom;
+  }
+
   statistics() << "Generated "
                << symex.total_vccs<<" VCC(s), "
                << symex.remaining_vccs
@@ -595,6 +655,126 @@ void bmct::setup_unwind()
     symex.set_unwind_limit(options.get_unsigned_int_option("unwind"));
 }
 
+/// Symbolically executes and checks the next path saved in \p worklist,
+/// saving any branch points not taken in \p worklist
+static safety_checkert::resultt explore_saved_path(
+  const optionst &opts,
+  const goto_modelt &goto_model,
+  const ui_message_handlert::uit &ui,
+  messaget &message,
+  std::function<void(bmct &, const goto_modelt &)> frontend_configure_bmc,
+  path_storaget &worklist)
+{
+  message.status() << "___________________________\n"
+                   << "Starting new path (" << worklist.size()
+                   << " to go)\n"
+                   << message.eom;
+  cbmc_solverst solvers(
+    opts, goto_model.symbol_table, message.get_message_handler());
+  solvers.set_ui(ui);
+  std::unique_ptr<cbmc_solverst::solvert> cbmc_solver;
+  cbmc_solver = solvers.get_solver();
+  prop_convt &pc = cbmc_solver->prop_conv();
+  path_storaget::patht &resume = worklist.peek();
+  path_explorert pe(
+    opts,
+    goto_model.symbol_table,
+    message.get_message_handler(),
+    pc,
+    resume.equation,
+    resume.state,
+    worklist);
+  frontend_configure_bmc(pe, goto_model);
+  safety_checkert::resultt result = pe.run(goto_model.goto_functions);
+  worklist.pop();
+  return result;
+}
+
+/// Explores all paths saved in \p worklist in parallel worker processes,
+/// leaving \p worklist empty.
+///
+/// Each saved branch point is one task; tasks are handed out to the workers
+/// from a shared queue as workers become idle. A worker explores the whole
+/// subtree of paths below its branch point, as saved states cannot be passed
+/// between processes. The output of each worker is replayed in task order,
+/// so that the result does not depend on scheduling.
+static safety_checkert::resultt explore_paths_in_workers(
+  const optionst &opts,
+  const goto_modelt &goto_model,
+  const ui_message_handlert::uit &ui,
+  messaget &message,
+  std::function<void(bmct &, const goto_modelt &)> frontend_configure_bmc,
+  path_storaget &worklist)
+{
+  const unsigned jobs=opts.get_unsigned_int_option("jobs");
+
+  message.status() << "Exploring " << worklist.size()
+                   << " saved paths in " << jobs << " worker processes"
+                   << message.eom;
+
+  // the worker answers with its result, followed by its messages
+  auto worker=[&](std::size_t task_number)
+  {
+    recording_message_handlert recorder;
+    recorder.set_verbosity(message.get_message_handler().get_verbosity());
+    messaget worker_message(recorder);
+
+    // only this worker's subtree; no nested workers
+    worklist.retain(task_number);
+    optionst worker_opts(opts);
+    worker_opts.set_option("jobs", 1);
+
+    safety_checkert::resultt result=safety_checkert::resultt::SAFE;
+    while(!worklist.empty())
+    {
+      result&=explore_saved_path(
+        worker_opts,
+        goto_model,
+        ui,
+        worker_message,
+        frontend_configure_bmc,
+        worklist);
+    }
+
+    char result_char=
+      result==safety_checkert::resultt::SAFE ? 'S' :
+      result==safety_checkert::resultt::UNSAFE ? 'U' : 'E';
+    return result_char+recorder.recorded;
+  };
+
+  const std::vector<optionalt<std::string>> answers=
+    run_forked_tasks(worklist.size(), jobs, worker);
+  worklist.clear();
+
+  safety_checkert::resultt result=safety_checkert::resultt::SAFE;
+
+  for(const auto &answer : answers)
+  {
+    if(!answer.has_value() || answer->empty())
+    {
+      message.error() << "path exploration worker failed" << message.eom;
+      result&=safety_checkert::resultt::ERROR;
+      continue;
+    }
+
+    recording_message_handlert::replay(
+      *answer, 1, message.get_message_handler());
+
+    switch((*answer)[0])
+    {
+    case 'S':
+      break;
+    case 'U':
+      result&=safety_checkert::resultt::UNSAFE;
+      break;
+    default:
+      result&=safety_checkert::resultt::ERROR;
+    }
+  }
+
+  return result;
+}
+
 int bmct::do_language_agnostic_bmc(
   const optionst &opts,
   const goto_modelt &goto_model,
@@ -604,9 +784,16 @@ int bmct::do_language_agnostic_bmc(
 {
   message_handlert &mh = message.get_message_handler();
   safety_checkert::resultt result;
-  goto_symext::branch_worklistt worklist;
+  std::unique_ptr<path_storaget> worklist=get_path_strategy(
+    opts.get_option("paths-strategy"), goto_model.goto_functions);
   try
   {
+    if(opts.get_bool_option("incremental-unwind"))
+    {
+      result=bmc_incrementalt::check_increasing_bounds(
+        opts, goto_model, ui, message, frontend_configure_bmc, *worklist);
+    }
+    else
     {
       cbmc_solverst solvers(
         opts, goto_model.symbol_table, message.get_message_handler());
@@ -614,16 +801,16 @@ int bmct::do_language_agnostic_bmc(
       std::unique_ptr<cbmc_solverst::solvert> cbmc_solver;
       cbmc_solver = solvers.get_solver();
       prop_convt &pc = cbmc_solver->prop_conv();
-      bmct bmc(opts, goto_model.symbol_table, mh, pc, worklist);
+      bmct bmc(opts, goto_model.symbol_table, mh, pc, *worklist);
       bmc.set_ui(ui);
       frontend_configure_bmc(bmc, goto_model);
       result = bmc.run(goto_model.goto_functions);
     }
     INVARIANT(
-      opts.get_bool_option("paths") || worklist.empty(),
+      opts.get_bool_option("paths") || worklist->empty(),
       "the worklist should be empty after doing full-program "
       "model checking, but the worklist contains " +
-        std::to_string(worklist.size()) + " unexplored branches.");
+        std::to_string(worklist->size()) + " unexplored branches.");
 
     // When model checking, the bmc.run() above will already have explored
     // the entire program, and result contains the verification result. The
@@ -640,30 +827,26 @@ int bmct::do_language_agnostic_bmc(
     // difference between the implementations of perform_symbolic_exection()
     // in bmct and path_explorert, for more information.
 
-    while(!worklist.empty())
+    //
+    // With --jobs, saved paths are explored in worker processes as soon as
+    // there are enough of them to keep all workers busy.
+    const unsigned jobs=opts.get_unsigned_int_option("jobs");
+    const bool use_workers=
+      jobs>1 &&
+      ui==ui_message_handlert::uit::PLAIN &&
+      forked_tasks_supported();
+
+    while(!worklist->empty())
     {
-      message.status() << "___________________________\n"
-                       << "Starting new path (" << worklist.size()
-                       << " to go)\n"
-                       << message.eom;
-      cbmc_solverst solvers(
-        opts, goto_model.symbol_table, message.get_message_handler());
-      solvers.set_ui(ui);
-      std::unique_ptr<cbmc_solverst::solvert> cbmc_solver;
-      cbmc_solver = solvers.get_solver();
-      prop_convt &pc = cbmc_solver->prop_conv();
-      goto_symext::branch_pointt &resume = worklist.front();
-      path_explorert pe(
-        opts,
-        goto_model.symbol_table,
-        mh,
-        pc,
-        resume.equation,
-        resume.state,
-        worklist);
-      frontend_configure_bmc(pe, goto_model);
-      result &= pe.run(goto_model.goto_functions);
-      worklist.pop_front();
+      if(use_workers && worklist->size()>=jobs)
+      {
+        result&=explore_paths_in_workers(
+          opts, goto_model, ui, message, frontend_configure_bmc, *worklist);
+        break;
+      }
+
+      result&=explore_saved_path(
+        opts, goto_model, ui, message, frontend_configure_bmc, *worklist);
     }
   }
   catch(const char *error_msg)
@@ -698,7 +881,7 @@ void bmct::perform_symbolic_execution(const goto_functionst &goto_functions)
 {
   symex.symex_from_entry_point_of(goto_functions, symex_symbol_table);
   INVARIANT(
-    options.get_bool_option("paths") || branch_worklist.empty(),
+    options.get_bool_option("paths") || path_storage.empty(),
     "Branch points were saved even though we should have been "
     "executing the entire program and merging paths");
 }
@@ -57,31 +57,31 @@ public:
   ///   constructor is `false` (unset), an instance of this class will
   ///   symbolically execute the entire program, performing path merging
   ///   to build a formula corresponding to all executions of the program
-  ///   up to the unwinding limit. In this case, the `branch_worklist`
+  ///   up to the unwinding limit. In this case, the `path_storage`
   ///   member shall not be touched; this is enforced by the assertion in
   ///   this class' implementation of bmct::perform_symbolic_execution().
   ///
   /// - If the `--paths` flag is `true`, this `bmct` object will explore a
   ///   single path through the codebase without doing any path merging.
   ///   If some paths were not taken, the state at those branch points
-  ///   will be appended to `branch_worklist`. After the single path that
+  ///   will be saved in `path_storage`. After the single path that
   ///   this `bmct` object executed has been model-checked, you can resume
-  ///   exploring further paths by popping an element from
-  ///   `branch_worklist` and using it to construct a path_explorert
-  ///   object.
+  ///   exploring further paths by peeking at the next path in
+  ///   `path_storage` and using it to construct a path_explorert
+  ///   object. The path storage decides which path that is.
   bmct(
     const optionst &_options,
     const symbol_tablet &outer_symbol_table,
     message_handlert &_message_handler,
     prop_convt &_prop_conv,
-    goto_symext::branch_worklistt &_branch_worklist)
+    path_storaget &_path_storage)
     : safety_checkert(ns, _message_handler),
       options(_options),
       outer_symbol_table(outer_symbol_table),
       ns(outer_symbol_table, symex_symbol_table),
       equation(),
-      branch_worklist(_branch_worklist),
-      symex(_message_handler, outer_symbol_table, equation, branch_worklist),
+      path_storage(_path_storage),
+      symex(_message_handler, outer_symbol_table, equation, path_storage),
       prop_conv(_prop_conv),
       ui(ui_message_handlert::uit::PLAIN)
   {
@@ -142,7 +142,7 @@ protected:
   ///
   /// This constructor exists as a delegate for the path_explorert class.
   /// It differs from \ref bmct's public constructor in that it actually
-  /// does something with the branch_worklistt argument, and also takes a
+  /// does something with the path_storaget argument, and also takes a
   /// symex_target_equationt. See the documentation for path_explorert for
   /// details.
   bmct(
@@ -151,14 +151,14 @@ protected:
     message_handlert &_message_handler,
     prop_convt &_prop_conv,
     symex_target_equationt &_equation,
-    goto_symext::branch_worklistt &_branch_worklist)
+    path_storaget &_path_storage)
     : safety_checkert(ns, _message_handler),
       options(_options),
       outer_symbol_table(outer_symbol_table),
       ns(outer_symbol_table),
       equation(_equation),
-      branch_worklist(_branch_worklist),
-      symex(_message_handler, outer_symbol_table, equation, branch_worklist),
+      path_storage(_path_storage),
+      symex(_message_handler, outer_symbol_table, equation, path_storage),
       prop_conv(_prop_conv),
       ui(ui_message_handlert::uit::PLAIN)
   {
@@ -178,7 +178,7 @@ protected:
   symbol_tablet symex_symbol_table;
   namespacet ns;
   symex_target_equationt equation;
-  goto_symext::branch_worklistt &branch_worklist;
+  path_storaget &path_storage;
   symex_bmct symex;
   prop_convt &prop_conv;
   std::unique_ptr<memory_model_baset> memory_model;
@@ -264,14 +264,14 @@ public:
     prop_convt &_prop_conv,
     symex_target_equationt &saved_equation,
     const goto_symex_statet &saved_state,
-    goto_symext::branch_worklistt &branch_worklist)
+    path_storaget &path_storage)
     : bmct(
         _options,
         outer_symbol_table,
         _message_handler,
         _prop_conv,
         saved_equation,
-        branch_worklist),
+        path_storage),
       saved_state(saved_state)
   {
   }
@@ -293,27 +293,43 @@ private:
   "(show-loops)"                                                               \
   "(show-vcc)"                                                                 \
   "(slice-formula)"                                                            \
+  "(rewrite-formula)"                                                          \
   "(unwinding-assertions)"                                                     \
   "(no-unwinding-assertions)"                                                  \
   "(no-pretty-names)"                                                          \
   "(partial-loops)"                                                            \
   "(paths)"                                                                    \
+  "(paths-strategy):"                                                          \
+  "(show-symex-strategies)"                                                    \
+  "(jobs):"                                                                    \
   "(depth):"                                                                   \
   "(unwind):"                                                                  \
+  "(incremental-unwind)"                                                       \
   "(unwindset):"                                                               \
   "(graphml-witness):"                                                         \
   "(unwindset):"
 
 #define HELP_BMC                                                               \
   " --paths                      explore paths one at a time\n"                \
+  " --paths-strategy s           order in which to explore saved paths\n"      \
+  " --show-symex-strategies      list strategies for use with --paths\n"       \
+  " --jobs n                     check properties or explore paths using n\n"  \
+  "                              worker processes; also used for checking\n"   \
+  "                              string axioms with --refine-strings\n"        \
   " --program-only               only show program expression\n"               \
   " --show-loops                 show the loops in the program\n"              \
   " --depth nr                   limit search depth\n"                         \
   " --unwind nr                  unwind nr times\n"                            \
+  " --incremental-unwind         check with unwinding bound 1, 2, ...\n"       \
+  "                              (up to the --unwind bound, if given)\n"       \
+  "                              in one SAT solver, stopping at the\n"         \
+  "                              first violation\n"                            \
   " --unwindset L:B,...          unwind loop L with a bound of B\n"            \
   "                              (use --show-loops to get the loop IDs)\n"     \
   " --show-vcc                   show the verification conditions\n"           \
   " --slice-formula              remove assignments unrelated to property\n"   \
+  " --rewrite-formula            propagate constants, copies and common\n"     \
+  "                              subterms before bit-blasting\n"               \
   " --unwinding-assertions       generate unwinding assertions\n"              \
   " --partial-loops              permit paths with partial loops\n"            \
   " --no-pretty-names            do not simplify identifiers\n"                \
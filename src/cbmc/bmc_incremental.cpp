@@ -0,0 +1,327 @@
+/*******************************************************************\
+
+Module: Bounded Model Checking with Increasing Unwinding Bounds
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Bounded Model Checking with Increasing Unwinding Bounds
+
+#include "bmc_incremental.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include <util/std_expr.h>
+
+#include <solvers/prop/literal_expr.h>
+
+#include "cbmc_solvers.h"
+
+/// \return literal that is true if one of \p violations is true
+static literalt disjunction_literal(
+  prop_convt &prop_conv,
+  const bvt &violations)
+{
+  if(violations.empty())
+    return const_literal(false);
+
+  exprt::operandst disjuncts;
+  disjuncts.reserve(violations.size());
+  for(const auto &l : violations)
+    disjuncts.push_back(literal_exprt(l));
+
+  return prop_conv.convert(disjunction(disjuncts));
+}
+
+literalt bmc_incrementalt::convert_bound(
+  literalt activation,
+  literalt &unwinding_violation)
+{
+  // the steps before this index are generated with any larger bound
+  const std::size_t stable=
+    symex.unwind_limit_reached() ?
+      symex.steps_before_unwind_limit() :
+      equation.SSA_steps.size();
+
+  std::vector<bool> &asserted=solver_state.asserted;
+  if(asserted.size()<stable)
+    asserted.resize(stable, false);
+
+  if(!solver_state.constraints_added)
+  {
+    for(const auto &constraint : bmc_constraints)
+      prop_conv.set_to_true(constraint);
+    solver_state.constraints_added=true;
+  }
+
+  bvt violations, unwinding_violations;
+  literalt assumption=const_literal(true);
+  std::size_t index=0;
+
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      step.guard_literal=const_literal(false);
+    else
+      step.guard_literal=prop_conv.convert(step.guard);
+
+    // the constraints that the step imposes
+    exprt::operandst constraints;
+
+    if(!step.ignore)
+    {
+      if(step.is_assignment() || step.is_constraint())
+        constraints.push_back(step.cond_expr);
+      else if(step.is_decl())
+        prop_conv.convert(step.cond_expr);
+
+      // unlike symex_target_equationt::convert_io, name the symbols after
+      // the step, as slicing may ignore different steps with each bound
+      std::size_t arg_nr=0;
+      for(const auto &arg : step.io_args)
+      {
+        if(arg.is_constant() ||
+           arg.id()==ID_string_constant)
+          step.converted_io_args.push_back(arg);
+        else
+        {
+          symbol_exprt symbol(
+            "symex::io::"+std::to_string(index)+"::"+std::to_string(arg_nr),
+            arg.type());
+          constraints.push_back(equal_exprt(arg, symbol));
+          step.converted_io_args.push_back(symbol);
+        }
+        arg_nr++;
+      }
+    }
+
+    if(index<stable)
+    {
+      // a step that is sliced away with this bound has not been added, and
+      // may be needed with a larger bound
+      if(!asserted[index] && !step.ignore)
+      {
+        for(const auto &constraint : constraints)
+          prop_conv.set_to_true(constraint);
+        asserted[index]=true;
+      }
+    }
+    else
+    {
+      for(const auto &constraint : constraints)
+        prop_conv.set_to_true(
+          implies_exprt(literal_exprt(activation), constraint));
+    }
+
+    if(step.is_assume() || step.is_goto())
+    {
+      if(step.ignore)
+        step.cond_literal=const_literal(true);
+      else
+        step.cond_literal=prop_conv.convert(step.cond_expr);
+
+      if(step.is_assume())
+      {
+        assumption=prop_conv.convert(
+          and_exprt(
+            literal_exprt(assumption),
+            literal_exprt(step.cond_literal)));
+      }
+    }
+    else if(step.is_assert())
+    {
+      step.cond_literal=prop_conv.convert(
+        implies_exprt(literal_exprt(assumption), step.cond_expr));
+
+      // unwinding assertions do not come from an assertion in the program
+      if(step.source.pc->is_assert())
+        violations.push_back(!step.cond_literal);
+      else
+        unwinding_violations.push_back(!step.cond_literal);
+    }
+
+    index++;
+  }
+
+  unwinding_violation=disjunction_literal(prop_conv, unwinding_violations);
+  return disjunction_literal(prop_conv, violations);
+}
+
+/// Solves under the assumption of \p activation and \p violation
+decision_proceduret::resultt bmc_incrementalt::solve(
+  literalt activation,
+  literalt violation)
+{
+  bvt assumptions;
+  assumptions.push_back(activation);
+  assumptions.push_back(violation);
+  prop_conv.set_assumptions(assumptions);
+
+  status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+  return prop_conv.dec_solve();
+}
+
+safety_checkert::resultt bmc_incrementalt::decide(
+  const goto_functionst &,
+  prop_convt &prop_conv)
+{
+  prop_conv.set_message_handler(get_message_handler());
+
+  // the memory model puts steps in front of the equation whose number may
+  // change from one bound to the next, which would shift the steps that
+  // solver_statet::asserted refers to
+  if(equation.has_threads())
+  {
+    error() << "--incremental-unwind does not support threads" << eom;
+    return resultt::ERROR;
+  }
+
+  status() << "Passing bound " << bound << " to "
+           << prop_conv.decision_procedure_text() << eom;
+
+  auto solver_start = std::chrono::steady_clock::now();
+
+  const literalt activation=prop_conv.convert(
+    symbol_exprt(
+      "bmc::incremental::activation"+std::to_string(bound),
+      bool_typet()));
+
+  literalt unwinding_violation;
+  const literalt property_violation=
+    convert_bound(activation, unwinding_violation);
+
+  // the new constraints may require further array and pointer constraints
+  prop_conv.reset_post_processing();
+
+  // with all but the last bound, unwinding assertions are expected to fail
+  decision_proceduret::resultt dec_result;
+  if(is_last_bound())
+  {
+    dec_result=solve(
+      activation,
+      prop_conv.convert(
+        or_exprt(
+          literal_exprt(property_violation),
+          literal_exprt(unwinding_violation))));
+  }
+  else
+  {
+    dec_result=solve(activation, property_violation);
+
+    // if the unwinding assertions hold, a larger bound won't add anything
+    if(dec_result==decision_proceduret::resultt::D_UNSATISFIABLE &&
+       options.get_bool_option("unwinding-assertions") &&
+       solve(activation, unwinding_violation)==
+         decision_proceduret::resultt::D_UNSATISFIABLE)
+    {
+      status() << "Program fully unwound with bound " << bound << eom;
+      fully_unwound=true;
+    }
+  }
+
+  {
+    auto solver_stop = std::chrono::steady_clock::now();
+    status() << "Runtime decision procedure: "
+             << std::chrono::duration<double>(solver_stop-solver_start).count()
+             << "s" << eom;
+  }
+
+  switch(dec_result)
+  {
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    report_success();
+    if(is_last_bound())
+      output_graphml(resultt::SAFE);
+    return resultt::SAFE;
+
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    if(options.get_bool_option("trace"))
+    {
+      error_trace();
+      output_graphml(resultt::UNSAFE);
+    }
+
+    report_failure();
+    return resultt::UNSAFE;
+
+  default:
+    error() << "decision procedure failed" << eom;
+
+    return resultt::ERROR;
+  }
+}
+
+void bmc_incrementalt::report_success()
+{
+  if(is_last_bound())
+    bmct::report_success();
+  else
+    status() << "No violation with unwinding bound " << bound << eom;
+}
+
+safety_checkert::resultt bmc_incrementalt::check_increasing_bounds(
+  const optionst &opts,
+  const goto_modelt &goto_model,
+  const ui_message_handlert::uit &ui,
+  messaget &message,
+  std::function<void(bmct &, const goto_modelt &)> frontend_configure_bmc,
+  path_storaget &worklist)
+{
+  cbmc_solverst solvers(
+    opts, goto_model.symbol_table, message.get_message_handler());
+  solvers.set_ui(ui);
+  std::unique_ptr<cbmc_solverst::solvert> cbmc_solver;
+  cbmc_solver = solvers.get_solver();
+  prop_convt &pc = cbmc_solver->prop_conv();
+
+  if(!pc.has_set_assumptions())
+  {
+    message.error() << "--incremental-unwind requires a SAT solver "
+                    << "that supports assumptions" << message.eom;
+    return resultt::ERROR;
+  }
+
+  // the solver must not eliminate variables that later bounds refer to
+  pc.set_all_frozen();
+
+  const unsigned max_bound=
+    opts.get_option("unwind").empty() ?
+      std::numeric_limits<unsigned>::max() :
+      opts.get_unsigned_int_option("unwind");
+
+  solver_statet solver_state;
+
+  for(unsigned bound=std::min(1u, max_bound); ; bound++)
+  {
+    message.status() << "___________________________\n"
+                     << "Unwinding bound " << bound << message.eom;
+
+    // the steps shared with earlier bounds must refer to the same nondet
+    // symbols and dynamic objects
+    goto_symext::reset_counters();
+
+    optionst bound_opts(opts);
+    bound_opts.set_option("unwind", bound);
+
+    bmc_incrementalt bmc(
+      bound_opts,
+      goto_model.symbol_table,
+      message.get_message_handler(),
+      pc,
+      worklist,
+      solver_state,
+      bound,
+      bound>=max_bound);
+    bmc.set_ui(ui);
+    frontend_configure_bmc(bmc, goto_model);
+
+    const resultt result=bmc.run(goto_model.goto_functions);
+    if(result!=resultt::SAFE || bmc.is_last_bound())
+      return result;
+  }
+}
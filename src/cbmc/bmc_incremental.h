@@ -0,0 +1,114 @@
+/*******************************************************************\
+
+Module: Bounded Model Checking with Increasing Unwinding Bounds
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Bounded Model Checking with Increasing Unwinding Bounds
+
+#ifndef CPROVER_CBMC_BMC_INCREMENTAL_H
+#define CPROVER_CBMC_BMC_INCREMENTAL_H
+
+#include <vector>
+
+#include "bmc.h"
+
+/// \brief Checks the program with the unwinding bound 1, 2, ... until a
+///   property fails, the program is fully unwound, or the bound given by
+///   `--unwind` is reached (`--incremental-unwind`)
+///
+/// All bounds share one SAT solver. The program is symbolically executed
+/// again for each bound, but the SSA steps that are generated before the
+/// bound first stops an unwinding are the same for all larger bounds. These
+/// steps are added to the solver just once and without condition. The
+/// remaining steps of a bound are added under an activation literal that is
+/// only assumed while checking this bound, which retracts them (and, with
+/// them, the unwinding assumptions of this bound) for all later bounds.
+///
+/// Unwinding assertions are only reported with the last bound. With
+/// `--unwinding-assertions`, a bound with which they cannot fail is the
+/// last bound, as the program is then fully unwound.
+class bmc_incrementalt:public bmct
+{
+public:
+  /// Bookkeeping about the shared solver that is kept from one bound to
+  /// the next
+  struct solver_statet
+  {
+    solver_statet():constraints_added(false)
+    {
+    }
+
+    /// Indexed by SSA step: whether the step has been added to the solver
+    /// without activation literal
+    std::vector<bool> asserted;
+
+    /// Whether bmct::bmc_constraints have been added
+    bool constraints_added;
+  };
+
+  bmc_incrementalt(
+    const optionst &_options,
+    const symbol_tablet &outer_symbol_table,
+    message_handlert &_message_handler,
+    prop_convt &_prop_conv,
+    path_storaget &_path_storage,
+    solver_statet &_solver_state,
+    unsigned _bound,
+    bool _last_bound)
+    : bmct(
+        _options,
+        outer_symbol_table,
+        _message_handler,
+        _prop_conv,
+        _path_storage),
+      solver_state(_solver_state),
+      bound(_bound),
+      last_bound(_last_bound),
+      fully_unwound(false)
+  {
+  }
+
+  /// \return true if no larger bound needs to be checked; only valid once
+  ///   symbolic execution has been done
+  bool is_last_bound() const
+  {
+    return last_bound || fully_unwound || !symex.unwind_limit_reached();
+  }
+
+  /// \brief Driver for `--incremental-unwind`, invoked from
+  ///   bmct::do_language_agnostic_bmc
+  static resultt check_increasing_bounds(
+    const optionst &opts,
+    const goto_modelt &goto_model,
+    const ui_message_handlert::uit &ui,
+    messaget &message,
+    std::function<void(bmct &, const goto_modelt &)> frontend_configure_bmc,
+    path_storaget &worklist);
+
+protected:
+  solver_statet &solver_state;
+  const unsigned bound;
+  const bool last_bound;
+
+  /// Set when the unwinding assertions are shown to hold with this bound
+  bool fully_unwound;
+
+  resultt decide(const goto_functionst &, prop_convt &) override;
+  void report_success() override;
+
+  /// Adds the SSA steps of this bound to the solver
+  /// \param activation: literal that enables the steps that are specific
+  ///   to this bound
+  /// \param [out] unwinding_violation: literal that is true if some
+  ///   unwinding assertion is violated
+  /// \return literal that is true if some other assertion is violated
+  literalt convert_bound(literalt activation, literalt &unwinding_violation);
+
+  decision_proceduret::resultt solve(literalt activation, literalt violation);
+};
+
+#endif // CPROVER_CBMC_BMC_INCREMENTAL_H
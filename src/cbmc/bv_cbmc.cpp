@@ -11,6 +11,16 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/arith_tools.h>
 #include <util/replace_expr.h>
 
+#include <solvers/sat/satcheck_cube_and_conquer.h>
+
+void bv_cbmct::set_split_literals(const bvt &literals)
+{
+  auto cube_and_conquer=dynamic_cast<satcheck_cube_and_conquert *>(&prop);
+
+  if(cube_and_conquer!=nullptr)
+    cube_and_conquer->set_split_literals(literals);
+}
+
 bvt bv_cbmct::convert_waitfor(const exprt &expr)
 {
   if(expr.operands().size()!=4)
@@ -20,6 +20,10 @@ public:
     propt &_prop):bv_pointerst(_ns, _prop) { }
   virtual ~bv_cbmct() { }
 
+  /// Passes \p literals on as the literals to split on first if the
+  /// formula is solved by cube-and-conquer, and ignores them otherwise
+  void set_split_literals(const bvt &literals);
+
 protected:
   // overloading
   virtual bvt convert_bitvector(const exprt &expr); // no cache
@@ -16,6 +16,39 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/sat/dimacs_cnf.h>
 
+cbmc_dimacst::cbmc_dimacst(
+  const namespacet &_ns,
+  dimacs_cnf_streamt &_prop,
+  std::ostream &_out):
+  bv_cbmct(_ns, _prop),
+  stream(&_prop),
+  stream_out(&_out)
+{
+}
+
+cbmc_dimacst::cbmc_dimacst(
+  const namespacet &_ns,
+  dimacs_cnft &_prop,
+  std::ostream &_out):
+  bv_cbmct(_ns, _prop),
+  stream(nullptr),
+  stream_out(&_out)
+{
+}
+
+cbmc_dimacst::~cbmc_dimacst()
+{
+  if(stream!=nullptr)
+  {
+    stream->write_problem_line();
+    write_mapping(*stream_out);
+  }
+  else if(stream_out!=nullptr)
+    write_dimacs(*stream_out);
+  else
+    write_dimacs(filename);
+}
+
 bool cbmc_dimacst::write_dimacs(const std::string &filename)
 {
   if(filename.empty() || filename=="-")
@@ -35,7 +68,13 @@ bool cbmc_dimacst::write_dimacs(const std::string &filename)
 bool cbmc_dimacst::write_dimacs(std::ostream &out)
 {
   dynamic_cast<dimacs_cnft&>(prop).write_dimacs_cnf(out);
+  write_mapping(out);
+
+  return false;
+}
 
+void cbmc_dimacst::write_mapping(std::ostream &out)
+{
   // we dump the mapping variable<->literals
   for(const auto &s : get_symbols())
   {
@@ -67,6 +106,4 @@ bool cbmc_dimacst::write_dimacs(std::ostream &out)
 
     out << "\n";
   }
-
-  return false;
 }
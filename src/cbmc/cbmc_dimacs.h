@@ -14,6 +14,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bv_cbmc.h"
 
+class dimacs_cnft;
+class dimacs_cnf_streamt;
+
 class cbmc_dimacst:public bv_cbmct
 {
 public:
@@ -22,19 +25,36 @@ public:
     propt &_prop,
     const std::string &_filename):
     bv_cbmct(_ns, _prop),
-    filename(_filename)
+    filename(_filename),
+    stream(nullptr),
+    stream_out(nullptr)
   {
   }
 
-  virtual ~cbmc_dimacst()
-  {
-    write_dimacs(filename);
-  }
+  /// \p _prop writes the clauses to \p _out as they are generated, and
+  /// the mapping of symbols to literals is appended when done
+  cbmc_dimacst(
+    const namespacet &_ns,
+    dimacs_cnf_streamt &_prop,
+    std::ostream &_out);
+
+  /// \p _prop keeps the clauses in memory, which are written to \p _out
+  /// when done, e.g., when \p _out cannot be rewound
+  cbmc_dimacst(
+    const namespacet &_ns,
+    dimacs_cnft &_prop,
+    std::ostream &_out);
+
+  virtual ~cbmc_dimacst();
 
 protected:
   std::string filename;
+  dimacs_cnf_streamt *stream;
+  std::ostream *stream_out;
+
   bool write_dimacs(const std::string &filename);
   bool write_dimacs(std::ostream &);
+  void write_mapping(std::ostream &);
 };
 
 #endif // CPROVER_CBMC_CBMC_DIMACS_H
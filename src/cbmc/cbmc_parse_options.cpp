@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cstdlib> // exit()
 #include <iostream>
 #include <memory>
+#include <set>
 
 #include <util/string2int.h>
 #include <util/config.h>
@@ -31,6 +32,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/instrument_preconditions.h>
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/goto_inline.h>
+#include <goto-programs/goto_model_cache.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
 #include <goto-programs/mm_io.h>
@@ -51,6 +53,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/string_abstraction.h>
 #include <goto-programs/string_instrumentation.h>
 
+#include <goto-symex/path_storage.h>
 #include <goto-symex/rewrite_union.h>
 #include <goto-symex/adjust_float_expressions.h>
 
@@ -110,6 +113,18 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("paths"))
     options.set_option("paths", true);
 
+  if(cmdline.isset("paths-strategy"))
+  {
+    const std::string strategy=cmdline.get_value("paths-strategy");
+    if(!is_valid_path_strategy(strategy))
+    {
+      error() << "unknown strategy `" << strategy
+              << "' -- use --show-symex-strategies for a list" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("paths-strategy", strategy);
+  }
+
   if(cmdline.isset("program-only"))
     options.set_option("program-only", true);
 
@@ -168,6 +183,31 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
+  if(cmdline.isset("jobs"))
+    options.set_option("jobs", cmdline.get_value("jobs"));
+
+  if(cmdline.isset("incremental-unwind"))
+  {
+    // each bound only checks whether some property fails, and the
+    // equation is converted to the solver bound by bound
+    if(cmdline.isset("paths") ||
+       cmdline.isset("cover") ||
+       cmdline.isset("localize-faults") ||
+       cmdline.isset("dimacs") ||
+       cmdline.isset("outfile") ||
+       cmdline.isset("all-properties") ||
+       cmdline.isset("all-claims") ||
+       cmdline.isset("show-vcc") ||
+       cmdline.isset("program-only"))
+    {
+      error() << "--incremental-unwind cannot be used with --paths, "
+              << "--cover, --localize-faults, --dimacs, --outfile, "
+              << "--all-properties, --show-vcc or --program-only" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("incremental-unwind", true);
+  }
+
   if(cmdline.isset("depth"))
     options.set_option("depth", cmdline.get_value("depth"));
 
@@ -233,6 +273,11 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  // rewrite the equation at word level
+  options.set_option(
+    "rewrite-formula",
+    cmdline.isset("rewrite-formula"));
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -246,6 +291,22 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("arrays-uf", "auto");
 
+  if(cmdline.isset("multiplier-encoding"))
+  {
+    const std::string encoding=cmdline.get_value("multiplier-encoding");
+
+    if(encoding!="shift-add" && encoding!="wallace-tree")
+    {
+      error() << "unknown multiplier encoding `" << encoding << "'" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("multiplier-encoding", encoding);
+  }
+
+  if(cmdline.isset("specialize-constant-operands"))
+    options.set_option("specialize-constant-operands", true);
+
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
 
@@ -285,6 +346,32 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("aig"))
     options.set_option("aig", true);
 
+  if(cmdline.isset("portfolio"))
+    options.set_option("portfolio", true);
+
+  if(cmdline.isset("cube-and-conquer"))
+  {
+    const unsigned depth=
+      unsafe_string2unsigned(cmdline.get_value("cube-and-conquer"));
+
+    if(depth==0 || depth>16)
+    {
+      error() << "--cube-and-conquer expects a number of split variables "
+              << "between 1 and 16" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("cube-and-conquer", depth);
+  }
+
+  if(cmdline.isset("aig")+cmdline.isset("portfolio")+
+     cmdline.isset("cube-and-conquer")>1)
+  {
+    error() << "only one of --aig, --portfolio and --cube-and-conquer "
+            << "can be used" << eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
   // SMT Options
   bool version_set=false;
 
@@ -306,6 +393,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("fpa"))
     options.set_option("fpa", true);
 
+  if(cmdline.isset("smt2-interactive"))
+    options.set_option("smt2-interactive", true);
+
 
   bool solver_set=false;
 
@@ -420,6 +510,12 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(cmdline.isset("show-symex-strategies"))
+  {
+    std::cout << show_path_strategies();
+    return CPROVER_EXIT_SUCCESS;
+  }
+
   //
   // command line options
   //
@@ -578,6 +674,66 @@ bool cbmc_parse_optionst::set_properties()
   return false;
 }
 
+/// Command-line options that only matter after the goto program has been
+/// processed, and thus don't distinguish cached goto models
+static const std::set<std::string> options_not_in_cache_key=
+{
+  "goto-model-cache",
+  "verbosity", "xml-ui", "json-ui", "timestamp",
+  "show-properties", "show-claims", "show-loops",
+  "show-goto-functions", "list-goto-functions",
+  "claim", "all-claims", "all-properties", "stop-on-fail",
+  "trace", "trace-json-extended", "graphml-witness",
+  "unwind", "unwindset", "depth", "incremental-unwind",
+  "unwinding-assertions", "no-unwinding-assertions", "partial-loops",
+  "paths", "paths-strategy", "jobs", "mm",
+  "slice-formula", "rewrite-formula", "slice-by-trace",
+  "no-propagation", "no-simplify-if",
+  "show-vcc", "program-only", "no-pretty-names",
+  "symex-coverage-report", "localize-faults", "localize-faults-method",
+  "beautify", "dimacs", "outfile", "no-sat-preprocessor",
+  "refine", "refine-arrays", "refine-arithmetic", "max-node-refinement",
+  "smt1", "smt2", "fpa", "cvc3", "cvc4", "boolector", "yices", "z3",
+  "opensmt", "mathsat", "smt2-interactive", "aig", "portfolio",
+  "cube-and-conquer",
+  "arrays-uf-always", "arrays-uf-never",
+  "multiplier-encoding", "specialize-constant-operands"
+};
+
+/// Builds the key of the goto model for the given command line
+/// \return true if the goto model cannot be cached
+static bool get_goto_model_cache_key(
+  const cmdlinet &cmdline,
+  goto_model_cachet &cache)
+{
+  // The contents of header files are not part of the key, hence only
+  // models read from goto binaries are cached.
+  for(const auto &file : cmdline.args)
+  {
+    if(!is_goto_binary(file))
+    {
+      cache.status() << "Not using the goto model cache, as `" << file
+                     << "' is not a goto binary" << messaget::eom;
+      return true;
+    }
+  }
+
+  cache.add_to_key("CBMC " CBMC_VERSION);
+
+  std::set<std::string> ignored=options_not_in_cache_key;
+  // the property slicer uses the property
+  if(!cmdline.isset("full-slice"))
+    ignored.insert("property");
+
+  cache.add_to_key(cmdline.options_as_string(ignored));
+
+  for(const auto &file : cmdline.args)
+    if(cache.add_file_to_key(file))
+      return true;
+
+  return false;
+}
+
 int cbmc_parse_optionst::get_goto_program(
   const optionst &options)
 {
@@ -589,16 +745,30 @@ int cbmc_parse_optionst::get_goto_program(
 
   try
   {
-    goto_model=initialize_goto_model(cmdline, get_message_handler());
+    goto_model_cachet cache(
+      cmdline.get_value("goto-model-cache"), get_message_handler());
+
+    const bool use_cache=
+      cmdline.isset("goto-model-cache") &&
+      !cmdline.isset("show-symbol-table") &&
+      !get_goto_model_cache_key(cmdline, cache);
 
-    if(cmdline.isset("show-symbol-table"))
+    if(!use_cache || cache.load(goto_model))
     {
-      show_symbol_table(goto_model, ui_message_handler.get_ui());
-      return CPROVER_EXIT_SUCCESS;
-    }
+      goto_model=initialize_goto_model(cmdline, get_message_handler());
 
-    if(process_goto_program(options))
-      return CPROVER_EXIT_INTERNAL_ERROR;
+      if(cmdline.isset("show-symbol-table"))
+      {
+        show_symbol_table(goto_model, ui_message_handler.get_ui());
+        return CPROVER_EXIT_SUCCESS;
+      }
+
+      if(process_goto_program(options))
+        return CPROVER_EXIT_INTERNAL_ERROR;
+
+      if(use_cache)
+        cache.store(goto_model);
+    }
 
     // show it?
     if(cmdline.isset("show-loops"))
@@ -917,6 +1087,9 @@ void cbmc_parse_optionst::help()
     " --show-parse-tree            show parse tree\n"
     " --show-symbol-table          show symbol table\n"
     HELP_SHOW_GOTO_FUNCTIONS
+    " --goto-model-cache dir       reuse goto programs read from goto binaries\n" // NOLINT(*)
+    "                              and processed by an earlier run, stored in\n" // NOLINT(*)
+    "                              the existing directory dir\n"
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
     "\n"
     "Program instrumentation options:\n"
@@ -946,14 +1119,26 @@ void cbmc_parse_optionst::help()
     " --cvc4                       use CVC4\n"
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
+    " --smt2-interactive           keep the SMT2 solver running between queries\n" // NOLINT(*)
     " --refine                     use refinement procedure (experimental)\n"
     " --refine-strings             use string refinement (experimental)\n"
     " --string-printable           add constraint that strings are printable (experimental)\n" // NOLINT(*)
     " --string-max-length          add constraint on the length of strings\n" // NOLINT(*)
     " --string-max-input-length    add constraint on the length of input strings\n" // NOLINT(*)
     " --outfile filename           output formula to given file\n"
+    " --portfolio                  race differently configured SAT solvers in\n" // NOLINT(*)
+    "                              separate processes\n"
+    " --cube-and-conquer n         split the formula on n variables into 2^n cubes\n" // NOLINT(*)
+    "                              and solve them in up to --jobs processes at\n" // NOLINT(*)
+    "                              a time, by default one per hardware thread\n" // NOLINT(*)
+    " --aig                        structurally hash and rewrite the formula as an\n" // NOLINT(*)
+    "                              and-inverter graph before clause generation\n" // NOLINT(*)
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --multiplier-encoding e      sum partial products by shift-add (default)\n" // NOLINT(*)
+    "                              or wallace-tree\n"
+    " --specialize-constant-operands  multiply by constants in canonical signed\n" // NOLINT(*)
+    "                              digit form, divide by powers of two by shifting\n" // NOLINT(*)
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
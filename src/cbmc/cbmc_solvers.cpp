@@ -26,6 +26,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/cvc/cvc_dec.h>
 #include <solvers/prop/aig_prop.h>
 #include <solvers/sat/dimacs_cnf.h>
+#include <solvers/sat/satcheck_cube_and_conquer.h>
+#include <solvers/sat/satcheck_portfolio.h>
 
 #include "bv_cbmc.h"
 #include "cbmc_dimacs.h"
@@ -92,8 +94,30 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
 {
   auto solver=util_make_unique<solvert>();
 
-  if(options.get_bool_option("beautify") ||
-     !options.get_bool_option("sat-preprocessor")) // no simplifier
+  if(options.get_bool_option("portfolio"))
+  {
+    solver->set_prop(
+      util_make_unique<satcheck_portfoliot>(
+        satcheck_portfoliot::default_configurations()));
+  }
+  else if(options.get_bool_option("cube-and-conquer"))
+  {
+    solver->set_prop(
+      util_make_unique<satcheck_cube_and_conquert>(
+        options.get_unsigned_int_option("cube-and-conquer"),
+        options.get_unsigned_int_option("jobs")));
+  }
+  else if(options.get_bool_option("aig"))
+  {
+    // The AIG is converted incrementally, and the clauses of later
+    // conversions may refer to any earlier node. The simplifier would
+    // eliminate those.
+    solver->set_back_end(util_make_unique<satcheck_no_simplifiert>());
+    solver->set_prop(
+      util_make_unique<aig_prop_solvert>(*solver->back_end_ptr));
+  }
+  else if(options.get_bool_option("beautify") ||
+          !options.get_bool_option("sat-preprocessor")) // no simplifier
   {
     // simplifier won't work with beautification
     solver->set_prop(util_make_unique<satcheck_no_simplifiert>());
@@ -112,6 +136,8 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
   else if(options.get_option("arrays-uf")=="always")
     bv_cbmc->unbounded_array=bv_cbmct::unbounded_arrayt::U_ALL;
 
+  set_arithmetic_encoding(*bv_cbmc);
+
   solver->set_prop_conv(std::move(bv_cbmc));
 
   return solver;
@@ -122,13 +148,58 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_dimacs()
   no_beautification();
   no_incremental_check();
 
-  auto prop=util_make_unique<dimacs_cnft>();
+  std::string filename=options.get_option("outfile");
+
+  if(filename.empty() || filename=="-")
+  {
+    // the standard output cannot be rewound to fill in the problem line,
+    // hence the clauses are kept in memory
+    auto prop=util_make_unique<dimacs_cnft>();
+    prop->set_message_handler(get_message_handler());
+
+    auto cbmc_dimacs=util_make_unique<cbmc_dimacst>(ns, *prop, filename);
+    set_arithmetic_encoding(*cbmc_dimacs);
+    return util_make_unique<solvert>(std::move(cbmc_dimacs), std::move(prop));
+  }
+
+  // the clauses are written to the file as they are generated
+  #ifdef _MSC_VER
+  auto out=util_make_unique<std::ofstream>(widen(filename));
+  #else
+  auto out=util_make_unique<std::ofstream>(filename);
+  #endif
+
+  if(!*out)
+  {
+    error() << "failed to open " << filename << eom;
+    throw 0;
+  }
+
+  if(out->tellp()==-1)
+  {
+    // neither can, e.g., a pipe
+    auto prop=util_make_unique<dimacs_cnft>();
+    prop->set_message_handler(get_message_handler());
+
+    auto cbmc_dimacs=util_make_unique<cbmc_dimacst>(ns, *prop, *out);
+    set_arithmetic_encoding(*cbmc_dimacs);
+
+    auto solver=
+      util_make_unique<solvert>(std::move(cbmc_dimacs), std::move(prop));
+    solver->set_ofstream(std::move(out));
+    return solver;
+  }
+
+  auto prop=util_make_unique<dimacs_cnf_streamt>(*out);
   prop->set_message_handler(get_message_handler());
 
-  std::string filename=options.get_option("outfile");
+  auto cbmc_dimacs=util_make_unique<cbmc_dimacst>(ns, *prop, *out);
+  set_arithmetic_encoding(*cbmc_dimacs);
 
-  auto cbmc_dimacs=util_make_unique<cbmc_dimacst>(ns, *prop, filename);
-  return util_make_unique<solvert>(std::move(cbmc_dimacs), std::move(prop));
+  auto solver=
+    util_make_unique<solvert>(std::move(cbmc_dimacs), std::move(prop));
+  solver->set_ofstream(std::move(out));
+  return solver;
 }
 
 std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_bv_refinement()
@@ -184,6 +255,7 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_string_refinement()
       options.get_unsigned_int_option("max-node-refinement");
   info.refine_arrays=options.get_bool_option("refine-arrays");
   info.refine_arithmetic=options.get_bool_option("refine-arithmetic");
+  info.jobs=options.get_unsigned_int_option("jobs");
 
   return util_make_unique<solvert>(
     util_make_unique<string_refinementt>(info), std::move(prop));
@@ -285,6 +357,9 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_smt2(
     if(options.get_bool_option("fpa"))
       smt2_dec->use_FPA_theory=true;
 
+    smt2_dec->interactive=options.get_bool_option("smt2-interactive");
+    smt2_dec->set_message_handler(get_message_handler());
+
     return util_make_unique<solvert>(std::move(smt2_dec));
   }
   else if(filename=="-")
@@ -350,9 +425,22 @@ void cbmc_solverst::no_incremental_check()
 {
   if(options.get_bool_option("all-properties") ||
      options.get_option("cover")!="" ||
-     options.get_option("incremental-check")!="")
+     options.get_option("incremental-check")!="" ||
+     options.get_bool_option("incremental-unwind"))
   {
     error() << "sorry, this solver does not support incremental solving" << eom;
     throw 0;
   }
 }
+
+void cbmc_solverst::set_arithmetic_encoding(boolbvt &solver) const
+{
+  const bv_utilst::multiplier_encodingt multiplier_encoding=
+    options.get_option("multiplier-encoding")=="wallace-tree"?
+      bv_utilst::multiplier_encodingt::WALLACE_TREE:
+      bv_utilst::multiplier_encodingt::SHIFT_ADD;
+
+  solver.set_arithmetic_encoding(
+    multiplier_encoding,
+    options.get_bool_option("specialize-constant-operands"));
+}
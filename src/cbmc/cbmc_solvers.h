@@ -97,8 +97,15 @@ public:
       ofstream_ptr=std::move(p);
     }
 
+    // for a prop that passes its clauses on to another one, e.g., an AIG
+    void set_back_end(std::unique_ptr<propt> p)
+    {
+      back_end_ptr=std::move(p);
+    }
+
     // the objects are deleted in the opposite order they appear below
     std::unique_ptr<std::ofstream> ofstream_ptr;
+    std::unique_ptr<propt> back_end_ptr;
     std::unique_ptr<propt> prop_ptr;
     std::unique_ptr<prop_convt> prop_conv_ptr;
   };
@@ -146,6 +153,8 @@ protected:
   // consistency checks during solver creation
   void no_beautification();
   void no_incremental_check();
+
+  void set_arithmetic_encoding(boolbvt &solver) const;
 };
 
 #endif // CPROVER_CBMC_CBMC_SOLVERS_H
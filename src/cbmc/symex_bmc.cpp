@@ -22,11 +22,13 @@ symex_bmct::symex_bmct(
   message_handlert &mh,
   const symbol_tablet &outer_symbol_table,
   symex_target_equationt &_target,
-  goto_symext::branch_worklistt &branch_worklist)
-  : goto_symext(mh, outer_symbol_table, _target, branch_worklist),
+  path_storaget &path_storage)
+  : goto_symext(mh, outer_symbol_table, _target, path_storage),
     record_coverage(false),
     max_unwind(0),
     max_unwind_is_set(false),
+    max_unwind_reached(false),
+    steps_before_max_unwind(0),
     symex_coverage(ns)
 {
 }
@@ -114,6 +116,7 @@ bool symex_bmct::get_unwind(
 
   tvt abort_unwind_decision;
   unsigned this_loop_limit=std::numeric_limits<unsigned>::max();
+  bool global_limit=false;
 
   for(auto handler : loop_unwind_handlers)
   {
@@ -146,7 +149,10 @@ bool symex_bmct::get_unwind(
       if(l_it!=loop_limits.end())
         this_loop_limit=l_it->second;
       else if(max_unwind_is_set)
+      {
         this_loop_limit=max_unwind;
+        global_limit=true;
+      }
     }
 
     abort_unwind_decision = tvt(unwind >= this_loop_limit);
@@ -156,6 +162,9 @@ bool symex_bmct::get_unwind(
     abort_unwind_decision.is_known(), "unwind decision should be taken by now");
   bool abort = abort_unwind_decision.is_true();
 
+  if(abort && global_limit)
+    note_max_unwind_reached();
+
   log.statistics() << (abort ? "Not unwinding" : "Unwinding") << " loop " << id
                    << " iteration " << unwind;
 
@@ -175,6 +184,7 @@ bool symex_bmct::get_unwind_recursion(
 {
   tvt abort_unwind_decision;
   unsigned this_loop_limit=std::numeric_limits<unsigned>::max();
+  bool global_limit=false;
 
   for(auto handler : recursion_unwind_handlers)
   {
@@ -202,7 +212,10 @@ bool symex_bmct::get_unwind_recursion(
       if(l_it!=loop_limits.end())
         this_loop_limit=l_it->second;
       else if(max_unwind_is_set)
+      {
         this_loop_limit=max_unwind;
+        global_limit=true;
+      }
     }
 
     abort_unwind_decision = tvt(unwind>this_loop_limit);
@@ -212,6 +225,9 @@ bool symex_bmct::get_unwind_recursion(
     abort_unwind_decision.is_known(), "unwind decision should be taken by now");
   bool abort = abort_unwind_decision.is_true();
 
+  if(abort && global_limit)
+    note_max_unwind_reached();
+
   if(unwind>0 || abort)
   {
     const symbolt &symbol=ns.lookup(id);
@@ -228,6 +244,15 @@ bool symex_bmct::get_unwind_recursion(
   return abort;
 }
 
+void symex_bmct::note_max_unwind_reached()
+{
+  if(!max_unwind_reached)
+  {
+    max_unwind_reached=true;
+    steps_before_max_unwind=target.SSA_steps.size();
+  }
+}
+
 void symex_bmct::no_body(const irep_idt &identifier)
 {
   if(body_warnings.insert(identifier).second)
@@ -26,7 +26,7 @@ public:
     message_handlert &mh,
     const symbol_tablet &outer_symbol_table,
     symex_target_equationt &_target,
-    goto_symext::branch_worklistt &branch_worklist);
+    path_storaget &path_storage);
 
   // To show progress
   source_locationt last_source_location;
@@ -100,6 +100,22 @@ public:
 
   bool record_coverage;
 
+  /// \return true if the global limit set by set_unwind_limit() stopped
+  ///   the unwinding of some loop or recursion
+  bool unwind_limit_reached() const
+  {
+    return max_unwind_reached;
+  }
+
+  /// \return the number of SSA steps that had been generated when the global
+  ///   limit first stopped an unwinding; all these steps would have been
+  ///   generated in the same way with any larger limit
+  std::size_t steps_before_unwind_limit() const
+  {
+    PRECONDITION(max_unwind_reached);
+    return steps_before_max_unwind;
+  }
+
 protected:
   // We have
   // 1) a global limit (max_unwind)
@@ -112,6 +128,10 @@ protected:
   unsigned max_unwind;
   bool max_unwind_is_set;
 
+  bool max_unwind_reached;
+  std::size_t steps_before_max_unwind;
+  void note_max_unwind_reached();
+
   typedef std::unordered_map<irep_idt, unsigned, irep_id_hash> loop_limitst;
   loop_limitst loop_limits;
 
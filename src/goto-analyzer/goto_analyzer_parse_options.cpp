@@ -15,6 +15,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <set>
+#include <sstream>
 
 #include <ansi-c/ansi_c_language.h>
 #include <cpp/cpp_language.h>
@@ -53,6 +55,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/string2int.h>
 #include <util/unicode.h>
 #include <util/exit_codes.h>
+#include <util/forked_tasks.h>
 
 #include <cbmc/version.h>
 
@@ -257,6 +260,8 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("location-sensitive", true);
     else if(cmdline.isset("concurrent"))
       options.set_option("concurrent", true);
+    else if(cmdline.isset("function-local"))
+      options.set_option("function-local", true);
     else
     {
       // Silently default to location-sensitive as it's the "default"
@@ -306,6 +311,43 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       }
     }
   }
+
+  if(cmdline.isset("summaries"))
+  {
+    if(!options.get_bool_option("location-sensitive"))
+    {
+      error() << "--summaries requires the location-sensitive abstract "
+              << "interpreter" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(options.get_bool_option("dependence-graph"))
+    {
+      // the transformer of the dependence graph adds edges to the states of
+      // other locations, which a summary does not capture
+      error() << "--summaries cannot be used with --dependence-graph" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("summaries", cmdline.get_value("summaries"));
+  }
+
+  if(cmdline.isset("jobs"))
+  {
+    // the workers' outputs are concatenated, which needs plain text, and
+    // only functions analysed on their own can be given to different workers
+    if(!options.get_bool_option("function-local") ||
+       !(options.get_bool_option("show") ||
+         options.get_bool_option("verify")) ||
+       !options.get_bool_option("text"))
+    {
+      error() << "--jobs requires --function-local and --show or --verify "
+              << "with text output" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("jobs", cmdline.get_value("jobs"));
+  }
 }
 
 /// For the task, build the appropriate kind of analyzer
@@ -317,7 +359,8 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
 {
   ai_baset *domain = nullptr;
 
-  if(options.get_bool_option("location-sensitive"))
+  if(options.get_bool_option("location-sensitive") ||
+     options.get_bool_option("function-local"))
   {
     if(options.get_bool_option("constants"))
     {
@@ -330,7 +373,7 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     }
     else if(options.get_bool_option("intervals"))
     {
-      domain=new ait<interval_domaint>();
+      domain=new interval_ait(goto_model.goto_functions);
     }
 #if 0
     // Not actually implemented, despite the option...
@@ -617,78 +660,59 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
-    // Build analyzer
-    status() << "Selecting abstract domain" << eom;
     namespacet ns(goto_model.symbol_table);  // Must live as long as the domain.
-    std::unique_ptr<ai_baset> analyzer(build_analyzer(options, ns));
-
-    if(analyzer == nullptr)
-    {
-      status() << "Task / Interpreter / Domain combination not supported"
-               << messaget::eom;
-      return CPROVER_EXIT_INTERNAL_ERROR;
-    }
-
+    bool result = true;
 
-    // Run
-    status() << "Computing abstract states" << eom;
-    (*analyzer)(goto_model);
+    const unsigned jobs=
+      options.get_option("jobs").empty() ?
+        1 : options.get_unsigned_int_option("jobs");
 
-    // Perform the task
-    status() << "Performing task" << eom;
-    bool result = true;
-    if(options.get_bool_option("show"))
-    {
-      result = static_show_domain(goto_model,
-                                  *analyzer,
-                                  options,
-                                  get_message_handler(),
-                                  out);
-    }
-    else if(options.get_bool_option("verify"))
-    {
-      result = static_verifier(goto_model,
-                               *analyzer,
-                               options,
-                               get_message_handler(),
-                               out);
-    }
-    else if(options.get_bool_option("simplify"))
-    {
-      result = static_simplifier(goto_model,
-                                 *analyzer,
-                                 options,
-                                 get_message_handler(),
-                                 out);
-    }
-    else if(options.get_bool_option("unreachable-instructions"))
-    {
-      result = static_unreachable_instructions(goto_model,
-                                               *analyzer,
-                                               options,
-                                               get_message_handler(),
-                                               out);
-    }
-    else if(options.get_bool_option("unreachable-functions"))
+    if(jobs>1 && forked_tasks_supported())
     {
-      result = static_unreachable_functions(goto_model,
-                                            *analyzer,
-                                            options,
-                                            get_message_handler(),
-                                            out);
-    }
-    else if(options.get_bool_option("reachable-functions"))
-    {
-      result = static_reachable_functions(goto_model,
-                                          *analyzer,
-                                          options,
-                                          get_message_handler(),
-                                          out);
+      if(perform_task_in_workers(options, ns, jobs, out, result))
+        return CPROVER_EXIT_INTERNAL_ERROR;
     }
     else
     {
-      error() << "Unhandled task" << eom;
-      return CPROVER_EXIT_INTERNAL_ERROR;
+      // Build analyzer
+      status() << "Selecting abstract domain" << eom;
+      std::unique_ptr<ai_baset> analyzer(build_analyzer(options, ns));
+
+      if(analyzer == nullptr)
+      {
+        status() << "Task / Interpreter / Domain combination not supported"
+                 << messaget::eom;
+        return CPROVER_EXIT_INTERNAL_ERROR;
+      }
+
+      // Run
+      status() << "Computing abstract states" << eom;
+      if(options.get_bool_option("function-local"))
+        analyzer->function_local(goto_model.goto_functions, ns);
+      else if(!options.get_option("summaries").empty())
+      {
+        analyzer->set_summaries(options.get_unsigned_int_option("summaries"));
+        (*analyzer)(goto_model);
+
+        const ai_baset::summary_statisticst &summary_statistics=
+          analyzer->get_summary_statistics();
+        statistics() << "Function summaries: "
+                     << summary_statistics.computed << " computed, "
+                     << summary_statistics.reused << " reused, "
+                     << summary_statistics.recursive << " recursive calls"
+                     << eom;
+      }
+      else
+        (*analyzer)(goto_model);
+
+      // Perform the task
+      status() << "Performing task" << eom;
+      if(perform_task(
+           options, *analyzer, get_message_handler(), out, result))
+      {
+        error() << "Unhandled task" << eom;
+        return CPROVER_EXIT_INTERNAL_ERROR;
+      }
     }
 
     return result ?
@@ -702,6 +726,180 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
   return CPROVER_EXIT_USAGE_ERROR;
 }
 
+/// Performs the task selected in \p options using the abstract states
+/// computed by \p analyzer
+/// \param [out] result: the result of the task
+/// \return true if no task is selected
+bool goto_analyzer_parse_optionst::perform_task(
+  const optionst &options,
+  const ai_baset &analyzer,
+  message_handlert &message_handler,
+  std::ostream &out,
+  bool &result)
+{
+  if(options.get_bool_option("show"))
+  {
+    result = static_show_domain(goto_model,
+                                analyzer,
+                                options,
+                                message_handler,
+                                out);
+  }
+  else if(options.get_bool_option("verify"))
+  {
+    result = static_verifier(goto_model,
+                             analyzer,
+                             options,
+                             message_handler,
+                             out);
+  }
+  else if(options.get_bool_option("simplify"))
+  {
+    result = static_simplifier(goto_model,
+                               analyzer,
+                               options,
+                               message_handler,
+                               out);
+  }
+  else if(options.get_bool_option("unreachable-instructions"))
+  {
+    result = static_unreachable_instructions(goto_model,
+                                             analyzer,
+                                             options,
+                                             message_handler,
+                                             out);
+  }
+  else if(options.get_bool_option("unreachable-functions"))
+  {
+    result = static_unreachable_functions(goto_model,
+                                          analyzer,
+                                          options,
+                                          message_handler,
+                                          out);
+  }
+  else if(options.get_bool_option("reachable-functions"))
+  {
+    result = static_reachable_functions(goto_model,
+                                        analyzer,
+                                        options,
+                                        message_handler,
+                                        out);
+  }
+  else
+    return true;
+
+  return false;
+}
+
+/// Analyses the functions and performs the task (--show or --verify, with
+/// text output) in up to \p jobs worker processes, using the function-local
+/// abstract interpreter. Each worker handles a contiguous share of the
+/// functions in the order in which the task reports them, hence their
+/// outputs are simply concatenated.
+/// \param [out] result: true if the task reports a problem in some worker
+/// \return true if some worker failed
+bool goto_analyzer_parse_optionst::perform_task_in_workers(
+  const optionst &options,
+  const namespacet &ns,
+  unsigned jobs,
+  std::ostream &out,
+  bool &result)
+{
+  std::vector<irep_idt> functions;
+  forall_goto_functions(f_it, goto_model.goto_functions)
+    if(f_it->second.body_available())
+      functions.push_back(f_it->first);
+
+  const std::size_t number_of_workers=
+    std::max<std::size_t>(
+      1, std::min(functions.size(), static_cast<std::size_t>(jobs)));
+
+  status() << "Computing abstract states and performing task in "
+           << number_of_workers << " worker processes" << eom;
+
+  // the answer of a worker is the result of the task ('0' or '1'), the
+  // length of what the task has output and a newline, the output, and then
+  // the messages of the task, such as the summary of --verify
+  auto worker=[&](std::size_t worker_number)
+  {
+    const std::set<irep_idt> share(
+      functions.begin()+functions.size()*worker_number/number_of_workers,
+      functions.begin()+functions.size()*(worker_number+1)/number_of_workers);
+
+    const auto in_share=[&share](const irep_idt &id)
+    {
+      return share.find(id)!=share.end();
+    };
+
+    std::unique_ptr<ai_baset> analyzer(build_analyzer(options, ns));
+    if(analyzer==nullptr)
+      return std::string();
+
+    analyzer->function_local(goto_model.goto_functions, ns, in_share);
+
+    // This process is discarded afterwards, hence we can remove the
+    // functions of the other workers from the model that the task reports
+    // on. Their bodies are kept alive elsewhere, as the abstract states may
+    // refer to their instructions.
+    goto_functionst other_functions;
+    auto &function_map=goto_model.goto_functions.function_map;
+    for(auto f_it=function_map.begin(); f_it!=function_map.end(); )
+    {
+      if(f_it->second.body_available() && !in_share(f_it->first))
+      {
+        other_functions.function_map[f_it->first].swap(f_it->second);
+        f_it=function_map.erase(f_it);
+      }
+      else
+        ++f_it;
+    }
+
+    recording_message_handlert recorder;
+    recorder.set_verbosity(get_message_handler().get_verbosity());
+    std::ostringstream task_out;
+    bool task_result;
+
+    if(perform_task(options, *analyzer, recorder, task_out, task_result))
+      return std::string();
+
+    const std::string output=task_out.str();
+
+    return (task_result ? "1" : "0")+
+           std::to_string(output.size())+'\n'+
+           output+
+           recorder.recorded;
+  };
+
+  const std::vector<optionalt<std::string>> answers=
+    run_forked_tasks(number_of_workers, jobs, worker);
+
+  result=false;
+
+  for(const auto &answer : answers)
+  {
+    if(!answer.has_value() || answer->empty())
+    {
+      error() << "worker process failed" << eom;
+      return true;
+    }
+
+    if((*answer)[0]=='1')
+      result=true;
+
+    const std::size_t newline=answer->find('\n');
+    const std::size_t length=
+      unsafe_string2size_t(answer->substr(1, newline-1));
+
+    out.write(answer->data()+newline+1, length);
+    out << std::flush;
+
+    recording_message_handlert::replay(
+      *answer, newline+1+length, get_message_handler());
+  }
+
+  return false;
+}
+
 bool goto_analyzer_parse_optionst::set_properties()
 {
   try
@@ -840,6 +1038,11 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --location-sensitive         use location-sensitive abstract interpreter\n"
     " --concurrent                 use concurrency-aware abstract interpreter\n"
+    " --function-local             analyse each function on its own\n"
+    " --summaries n                reuse the effect of a function on up to n\n"
+    "                              entry states (location-sensitive)\n"
+    " --jobs n                     analyse functions in n worker processes\n"
+    "                              (with --function-local)\n"
     "\n"
     "Domain options:\n"
     " --constants                  constant domain\n"
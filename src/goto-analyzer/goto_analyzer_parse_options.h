@@ -147,7 +147,8 @@ class optionst;
   "(constants)" \
   "(dependence-graph)" \
   "(show)(verify)(simplify):" \
-  "(location-sensitive)(concurrent)" \
+  "(location-sensitive)(concurrent)(function-local)" \
+  "(jobs):(summaries):" \
   "(no-simplify-slicing)" \
   JAVA_BYTECODE_LANGUAGE_OPTIONS
 // clang-format on
@@ -177,6 +178,20 @@ protected:
 
   ai_baset *build_analyzer(const optionst &, const namespacet &ns);
 
+  bool perform_task(
+    const optionst &options,
+    const ai_baset &analyzer,
+    message_handlert &message_handler,
+    std::ostream &out,
+    bool &result);
+
+  bool perform_task_in_workers(
+    const optionst &options,
+    const namespacet &ns,
+    unsigned jobs,
+    std::ostream &out,
+    bool &result);
+
   void eval_verbosity();
 
   ui_message_handlert::uit get_ui()
@@ -21,6 +21,7 @@ Author: Peter Schrammel
 extern unsigned long long irep_hash_cnt;
 extern unsigned long long irep_cmp_cnt;
 extern unsigned long long irep_cmp_ne_cnt;
+extern unsigned long long irep_cmp_ptr_cnt;
 #endif
 
 #ifdef _MSC_VER
@@ -41,6 +42,7 @@ int main(int argc, const char **argv)
   std::cout << "IREP_HASH_CNT=" << irep_hash_cnt << '\n';
   std::cout << "IREP_CMP_CNT=" << irep_cmp_cnt << '\n';
   std::cout << "IREP_CMP_NE_CNT=" << irep_cmp_ne_cnt << '\n';
+  std::cout << "IREP_CMP_PTR_CNT=" << irep_cmp_ptr_cnt << '\n';
   #endif
 
   return res;
@@ -0,0 +1,180 @@
+/*******************************************************************\
+
+Module: On-disk Cache of Processed Goto Models
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// On-disk Cache of Processed Goto Models
+
+#include "goto_model_cache.h"
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#endif
+
+#if defined(__linux__) || \
+    defined(__FreeBSD_kernel__) || \
+    defined(__GNU__) || \
+    defined(__unix__) || \
+    defined(__CYGWIN__) || \
+    defined(__MACH__)
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <util/config.h>
+#include <util/file_util.h>
+#include <util/unicode.h>
+
+#include "goto_model.h"
+#include "read_goto_binary.h"
+#include "write_goto_binary.h"
+
+goto_model_cachet::goto_model_cachet(
+  const std::string &_directory,
+  message_handlert &_message_handler):
+  messaget(_message_handler),
+  directory(_directory),
+  fnv_hash(14695981039346656037ull),
+  djb_hash(5381),
+  key_size(0)
+{
+  // models are stored in this format
+  add_to_key("goto binary version "+std::to_string(GOTO_BINARY_VERSION));
+}
+
+void goto_model_cachet::add_bytes(const char *data, std::size_t size)
+{
+  for(std::size_t i=0; i<size; i++)
+  {
+    const unsigned char c=data[i];
+    fnv_hash=(fnv_hash^c)*1099511628211ull;
+    djb_hash=(djb_hash<<5)+djb_hash+c;
+  }
+
+  key_size+=size;
+}
+
+void goto_model_cachet::add_to_key(const std::string &text)
+{
+  // the length keeps apart different splits of the same characters
+  const std::string length=std::to_string(text.size())+':';
+  add_bytes(length.data(), length.size());
+  add_bytes(text.data(), text.size());
+}
+
+bool goto_model_cachet::add_file_to_key(const std::string &file_name)
+{
+  #ifdef _MSC_VER
+  std::ifstream in(widen(file_name), std::ios::binary);
+  #else
+  std::ifstream in(file_name, std::ios::binary);
+  #endif
+
+  if(!in)
+  {
+    error() << "failed to open `" << file_name << "'" << eom;
+    return true;
+  }
+
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  add_to_key(contents.str());
+
+  return false;
+}
+
+std::string goto_model_cachet::file_name() const
+{
+  std::ostringstream name;
+  name << std::hex << std::setfill('0')
+       << std::setw(16) << fnv_hash
+       << std::setw(16) << djb_hash
+       << '-' << std::dec << key_size << ".gb";
+
+  return concat_dir_file(directory, name.str());
+}
+
+bool goto_model_cachet::load(goto_modelt &dest)
+{
+  const std::string cached=file_name();
+
+  #ifdef _MSC_VER
+  std::ifstream in(widen(cached), std::ios::binary);
+  #else
+  std::ifstream in(cached, std::ios::binary);
+  #endif
+
+  if(!in)
+  {
+    status() << "Goto model is not cached yet" << eom;
+    return true;
+  }
+
+  in.close();
+
+  status() << "Reading cached goto model " << cached << eom;
+
+  goto_modelt cached_model;
+  if(read_goto_binary(cached, cached_model, get_message_handler()))
+  {
+    warning() << "ignoring unreadable cached goto model" << eom;
+    return true;
+  }
+
+  // neither location nor loop numbers are part of goto binaries
+  cached_model.goto_functions.update();
+  cached_model.goto_functions.compute_loop_numbers();
+
+  config.set_from_symbol_table(cached_model.symbol_table);
+
+  dest=std::move(cached_model);
+  return false;
+}
+
+bool goto_model_cachet::store(const goto_modelt &goto_model)
+{
+  const std::string cached=file_name();
+
+  // write under a name of our own, then move into place, so that other
+  // processes never see a partially written model
+  const std::string partial=
+    cached+"."+std::to_string(getpid())+".tmp";
+
+  {
+    #ifdef _MSC_VER
+    std::ofstream out(widen(partial), std::ios::binary);
+    #else
+    std::ofstream out(partial, std::ios::binary);
+    #endif
+
+    if(!out ||
+       write_goto_binary(out, goto_model) ||
+       !out.flush())
+    {
+      warning() << "failed to write goto model to cache directory `"
+                << directory << "'" << eom;
+      out.close();
+      std::remove(partial.c_str());
+      return true;
+    }
+  }
+
+  if(std::rename(partial.c_str(), cached.c_str())!=0)
+  {
+    // another process may have stored the same model in the meantime
+    std::remove(partial.c_str());
+    return true;
+  }
+
+  status() << "Stored goto model in cache as " << cached << eom;
+  return false;
+}
@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+Module: On-disk Cache of Processed Goto Models
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// On-disk Cache of Processed Goto Models
+
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_MODEL_CACHE_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_MODEL_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include <util/message.h>
+
+class goto_modelt;
+
+/// \brief A directory of goto models that have been read, linked and
+///   processed before, stored as goto binaries
+///
+/// A model is stored under a key, which is a digest of everything that
+/// determined it: typically the contents of the input files, the options
+/// that affect linking and instrumentation, and the version of the tool.
+/// The caller builds the key using add_to_key() and add_file_to_key() before
+/// calling load() or store(). Several processes may share a cache directory;
+/// a model becomes visible to them only once it has been written completely.
+class goto_model_cachet:public messaget
+{
+public:
+  goto_model_cachet(
+    const std::string &_directory,
+    message_handlert &_message_handler);
+
+  void add_to_key(const std::string &text);
+
+  /// Adds the contents of \p file_name to the key
+  /// \return true on error
+  bool add_file_to_key(const std::string &file_name);
+
+  /// Reads the model stored under the current key into \p dest, and makes
+  /// the configuration match it
+  /// \return true if there is no such model
+  bool load(goto_modelt &dest);
+
+  /// Stores \p goto_model under the current key
+  /// \return true on error
+  bool store(const goto_modelt &goto_model);
+
+  /// \return the name of the file that holds the model for the current key
+  std::string file_name() const;
+
+protected:
+  std::string directory;
+
+  // two independent 64-bit hashes of all that was added to the key
+  std::uint64_t fnv_hash;
+  std::uint64_t djb_hash;
+  std::uint64_t key_size;
+
+  void add_bytes(const char *data, std::size_t size);
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_GOTO_MODEL_CACHE_H
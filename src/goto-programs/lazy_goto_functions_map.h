@@ -10,6 +10,7 @@
 
 #include "goto_functions.h"
 #include "goto_convert_functions.h"
+#include "mapped_goto_binary.h"
 
 #include <util/message.h>
 #include <langapi/language_file.h>
@@ -64,6 +65,9 @@ private:
   mutable std::unordered_set<irep_idt, irep_id_hash> processed_functions;
 
   language_filest &language_files;
+  /// If set, the goto binary that holds the bodies of the functions that
+  /// are not converted from language_files
+  const std::unique_ptr<mapped_goto_binaryt> &goto_binary;
   symbol_tablet &symbol_table;
   const post_process_functiont post_process_function;
   message_handlert &message_handler;
@@ -73,11 +77,13 @@ public:
   lazy_goto_functions_mapt(
     underlying_mapt &goto_functions,
     language_filest &language_files,
+    const std::unique_ptr<mapped_goto_binaryt> &goto_binary,
     symbol_tablet &symbol_table,
     post_process_functiont post_process_function,
     message_handlert &message_handler)
   : goto_functions(goto_functions),
     language_files(language_files),
+    goto_binary(goto_binary),
     symbol_table(symbol_table),
     post_process_function(std::move(post_process_function)),
     message_handler(message_handler)
@@ -107,10 +113,19 @@ public:
   ///   it a bodyless stub.
   bool can_produce_function(const key_type &name) const
   {
-    return language_files.can_convert_lazy_method(name);
+    return language_files.can_convert_lazy_method(name) ||
+           (goto_binary && goto_binary->has_function(name));
   }
 
-  void unload(const key_type &name) const { goto_functions.erase(name); }
+  /// Drops the body of function \p name, which is converted again from the
+  /// symbol table the next time it is requested
+  void unload(const key_type &name) const
+  {
+    goto_functions.erase(name);
+    // the body in the goto binary is out of date
+    if(goto_binary)
+      goto_binary->forget_function(name);
+  }
 
   void ensure_function_loaded(const key_type &name) const
   {
@@ -153,14 +168,23 @@ private:
     underlying_mapt::iterator it=goto_functions.find(name);
     if(it!=goto_functions.end())
       return *it;
-    // Fill in symbol table entry body if not already done
-    // If this returns false then it's a stub
-    language_files.convert_lazy_method(name, function_symbol_table);
-    // Create goto_functiont
     goto_functionst::goto_functiont function;
-    goto_convert_functionst convert_functions(
-      function_symbol_table, message_handler);
-    convert_functions.convert_function(name, function);
+    if(goto_binary && goto_binary->has_function(name))
+    {
+      // Decode the body from the goto binary
+      function.type=to_code_type(function_symbol_table.lookup_ref(name).type);
+      goto_binary->read_function(name, function);
+    }
+    else
+    {
+      // Fill in symbol table entry body if not already done
+      // If this returns false then it's a stub
+      language_files.convert_lazy_method(name, function_symbol_table);
+      // Create goto_functiont
+      goto_convert_functionst convert_functions(
+        function_symbol_table, message_handler);
+      convert_functions.convert_function(name, function);
+    }
     // Add to map
     return *goto_functions.emplace(name, std::move(function)).first;
   }
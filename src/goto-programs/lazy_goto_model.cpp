@@ -12,6 +12,7 @@
 #include <util/cmdline.h>
 #include <util/config.h>
 #include <util/journalling_symbol_table.h>
+#include <util/make_unique.h>
 #include <util/unicode.h>
 
 #include <langapi/language.h>
@@ -28,6 +29,7 @@ lazy_goto_modelt::lazy_goto_modelt(
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      goto_binary,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -55,6 +57,7 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      goto_binary,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -70,6 +73,7 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
       },
       other.message_handler),
     language_files(std::move(other.language_files)),
+    goto_binary(std::move(other.goto_binary)),
     post_process_function(std::move(other.post_process_function)),
     post_process_functions(std::move(other.post_process_functions)),
     message_handler(other.message_handler)
@@ -153,12 +157,30 @@ void lazy_goto_modelt::initialize(const cmdlinet &cmdline)
     }
   }
 
-  for(const std::string &file : binaries)
+  if(sources.empty() &&
+     binaries.size()==1 &&
+     mapped_goto_binaryt::has_index(binaries.front()))
   {
-    msg.status() << "Reading GOTO program from file" << messaget::eom;
+    // Nothing needs to be linked, hence function bodies are only decoded
+    // from the binary once they are needed
+    msg.status() << "Mapping GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, *goto_model, message_handler))
+    goto_binary=util_make_unique<mapped_goto_binaryt>(message_handler);
+    if(goto_binary->open(binaries.front()))
       throw 0;
+
+    goto_binary->read_symbol_table(symbol_table);
+    config.set_from_symbol_table(symbol_table);
+  }
+  else
+  {
+    for(const std::string &file : binaries)
+    {
+      msg.status() << "Reading GOTO program from file" << messaget::eom;
+
+      if(read_object_and_link(file, *goto_model, message_handler))
+        throw 0;
+    }
   }
 
   bool binaries_provided_start =
@@ -47,6 +47,7 @@ public:
   {
     goto_model = std::move(other.goto_model);
     language_files = std::move(other.language_files);
+    goto_binary = std::move(other.goto_binary);
     return *this;
   }
 
@@ -112,6 +113,9 @@ public:
 private:
   const lazy_goto_functions_mapt goto_functions;
   language_filest language_files;
+  /// Set if the program is a single goto binary with an index, whose function
+  /// bodies are then decoded on demand
+  std::unique_ptr<mapped_goto_binaryt> goto_binary;
 
   // Function/module processing functions
   const post_process_functiont post_process_function;
@@ -0,0 +1,265 @@
+/*******************************************************************\
+
+Module: Memory-mapped Goto Binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Memory-mapped Goto Binaries
+
+#include "mapped_goto_binary.h"
+
+#ifdef _WIN32
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <vector>
+
+#include <util/irep_serialization.h>
+#include <util/symbol_table.h>
+#include <util/unicode.h>
+
+#include "read_bin_goto_object.h"
+
+/// Reads from memory that belongs to somebody else
+class memory_streambuft:public std::streambuf
+{
+public:
+  memory_streambuft(const char *data, std::size_t size)
+  {
+    // the buffer is never written to
+    char *begin=const_cast<char *>(data);
+    setg(begin, begin, begin+size);
+  }
+
+  std::size_t position() const
+  {
+    return gptr()-eback();
+  }
+};
+
+mapped_goto_binaryt::mapped_goto_binaryt(
+  message_handlert &_message_handler):
+  messaget(_message_handler),
+  data(nullptr),
+  size(0),
+  symbol_section{0, 0}
+{
+}
+
+mapped_goto_binaryt::~mapped_goto_binaryt()
+{
+  unmap();
+}
+
+void mapped_goto_binaryt::unmap()
+{
+  #ifndef _WIN32
+  if(data!=nullptr)
+    munmap(const_cast<char *>(data), size);
+  #endif
+
+  data=nullptr;
+  size=0;
+  function_sections.clear();
+}
+
+bool mapped_goto_binaryt::has_index(const std::string &filename)
+{
+  #ifdef _MSC_VER
+  std::ifstream in(widen(filename), std::ios::binary);
+  #else
+  std::ifstream in(filename, std::ios::binary);
+  #endif
+
+  if(!in)
+    return false;
+
+  char hdr[4];
+  hdr[0]=static_cast<char>(in.get());
+  hdr[1]=static_cast<char>(in.get());
+  hdr[2]=static_cast<char>(in.get());
+  hdr[3]=static_cast<char>(in.get());
+
+  if(!in || hdr[0]!=0x7f || hdr[1]!='G' || hdr[2]!='B' || hdr[3]!='F')
+    return false;
+
+  const std::size_t version=irep_serializationt::read_gb_word(in);
+  return in && version>=4;
+}
+
+bool mapped_goto_binaryt::open(const std::string &_filename)
+{
+  unmap();
+  filename=_filename;
+
+  #ifdef _WIN32
+  {
+    #ifdef _MSC_VER
+    std::ifstream in(widen(filename), std::ios::binary);
+    #else
+    std::ifstream in(filename, std::ios::binary);
+    #endif
+
+    if(!in)
+    {
+      error() << "failed to open `" << filename << "'" << eom;
+      return true;
+    }
+
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents=buffer.str();
+  }
+
+  const char *file_data=contents.data();
+  const std::size_t file_size=contents.size();
+  #else
+  const int fd=::open(filename.c_str(), O_RDONLY);
+
+  if(fd<0)
+  {
+    error() << "failed to open `" << filename << "'" << eom;
+    return true;
+  }
+
+  struct stat info;
+  if(fstat(fd, &info)!=0 || info.st_size==0)
+  {
+    close(fd);
+    error() << "`" << filename << "' is not a goto-binary" << eom;
+    return true;
+  }
+
+  const std::size_t file_size=info.st_size;
+  void *mapping=mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping remains valid without the descriptor
+  close(fd);
+
+  if(mapping==MAP_FAILED)
+  {
+    error() << "failed to map `" << filename << "' into memory" << eom;
+    return true;
+  }
+
+  const char *file_data=static_cast<const char *>(mapping);
+  #endif
+
+  data=file_data;
+  size=file_size;
+
+  memory_streambuft buffer(data, size);
+  std::istream in(&buffer);
+
+  char hdr[4];
+  in.read(hdr, 4);
+
+  if(!in || hdr[0]!=0x7f || hdr[1]!='G' || hdr[2]!='B' || hdr[3]!='F' ||
+     irep_serializationt::read_gb_word(in)!=4)
+  {
+    error() << "`" << filename << "' is not a goto-binary of version 4"
+            << eom;
+    unmap();
+    return true;
+  }
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  symbol_section.size=irepconverter.read_gb_word(in);
+  const std::size_t count=irepconverter.read_gb_word(in); // # of functions
+
+  std::vector<std::pair<irep_idt, std::size_t>> function_sizes;
+  function_sizes.reserve(count);
+
+  for(std::size_t i=0; i<count && in; i++)
+  {
+    const irep_idt fname=irepconverter.read_gb_string(in);
+    function_sizes.emplace_back(fname, irepconverter.read_gb_word(in));
+  }
+
+  // the sections follow the index in the order given by it
+  std::size_t offset=buffer.position();
+  bool truncated=!in;
+
+  symbol_section.offset=offset;
+  offset+=symbol_section.size;
+  truncated|=offset>size;
+
+  for(const auto &function : function_sizes)
+  {
+    function_sections[function.first]=sectiont{offset, function.second};
+    offset+=function.second;
+    truncated|=offset>size;
+  }
+
+  if(truncated)
+  {
+    error() << "`" << filename << "' is truncated" << eom;
+    unmap();
+    return true;
+  }
+
+  return false;
+}
+
+void mapped_goto_binaryt::read_symbol_table(symbol_tablet &symbol_table) const
+{
+  PRECONDITION(data!=nullptr);
+
+  memory_streambuft buffer(data+symbol_section.offset, symbol_section.size);
+  std::istream in(&buffer);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  std::size_t count=irepconverter.read_gb_word(in); // # of symbols
+
+  for(std::size_t i=0; i<count; i++)
+  {
+    symbolt sym;
+    read_bin_goto_symbol(in, irepconverter, sym);
+    symbol_table.add(sym);
+  }
+
+  if(!in)
+  {
+    error() << "failed to read the symbol table of `" << filename << "'"
+            << eom;
+    throw 0;
+  }
+}
+
+void mapped_goto_binaryt::read_function(
+  const irep_idt &name,
+  goto_functionst::goto_functiont &function) const
+{
+  const auto s_it=function_sections.find(name);
+  PRECONDITION(s_it!=function_sections.end());
+
+  const sectiont &section=s_it->second;
+  memory_streambuft buffer(data+section.offset, section.size);
+  std::istream in(&buffer);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  read_bin_goto_function_body(in, irepconverter, function);
+
+  if(!in)
+  {
+    error() << "failed to read function `" << name << "' from `"
+            << filename << "'" << eom;
+    throw 0;
+  }
+}
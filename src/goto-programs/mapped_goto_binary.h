@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Memory-mapped Goto Binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Memory-mapped Goto Binaries
+
+#ifndef CPROVER_GOTO_PROGRAMS_MAPPED_GOTO_BINARY_H
+#define CPROVER_GOTO_PROGRAMS_MAPPED_GOTO_BINARY_H
+
+#include <string>
+#include <unordered_map>
+
+#include <util/message.h>
+
+#include "goto_functions.h"
+
+class symbol_tablet;
+
+/// \brief A goto binary of version 4 that is mapped into memory, and whose
+///   symbol table and function bodies are decoded only when asked for
+///
+/// Version 4 starts with an index of the sections that hold the symbol table
+/// and the function bodies (see write_goto_binary_v4). Opening the binary
+/// only reads this index; the pages that hold a function body are not even
+/// read from disc unless this function is decoded.
+class mapped_goto_binaryt:public messaget
+{
+public:
+  explicit mapped_goto_binaryt(message_handlert &_message_handler);
+  ~mapped_goto_binaryt();
+
+  mapped_goto_binaryt(const mapped_goto_binaryt &)=delete;
+  mapped_goto_binaryt &operator=(const mapped_goto_binaryt &)=delete;
+
+  /// \return true if \p filename is a goto binary with an index, i.e., of
+  ///   version 4 or later
+  static bool has_index(const std::string &filename);
+
+  /// Maps \p filename into memory and reads its index
+  /// \return true on error
+  bool open(const std::string &filename);
+
+  /// Adds the symbols of the binary to \p symbol_table
+  void read_symbol_table(symbol_tablet &symbol_table) const;
+
+  /// \return true if the binary holds a body for function \p name
+  bool has_function(const irep_idt &name) const
+  {
+    return function_sections.find(name)!=function_sections.end();
+  }
+
+  /// Drops function \p name from the index, e.g., as its body has been
+  /// rebuilt from the symbol table, so that the body in the binary is not
+  /// decoded again
+  void forget_function(const irep_idt &name)
+  {
+    function_sections.erase(name);
+  }
+
+  /// Decodes the body of function \p name, which the binary must hold, into
+  /// \p function. The type of \p function is expected to be set already.
+  void read_function(
+    const irep_idt &name,
+    goto_functionst::goto_functiont &function) const;
+
+  std::size_t number_of_functions() const
+  {
+    return function_sections.size();
+  }
+
+protected:
+  std::string filename;
+  const char *data;
+  std::size_t size;
+
+  #ifdef _WIN32
+  // there is no mmap, hence we hold a copy of the file
+  std::string contents;
+  #endif
+
+  struct sectiont
+  {
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  sectiont symbol_section;
+  std::unordered_map<irep_idt, sectiont, irep_id_hash> function_sections;
+
+  void unmap();
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_MAPPED_GOTO_BINARY_H
@@ -13,6 +13,8 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <vector>
+
 #include <util/namespace.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
@@ -20,15 +22,126 @@ Date: June 2006
 
 #include "goto_functions.h"
 
-/// read goto binary format v3
-/// \par parameters: input stream, symbol_table, functions
-/// \return true on error, false otherwise
-bool read_bin_goto_object_v3(
+void read_bin_goto_symbol(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  symbolt &sym)
+{
+  irepconverter.reference_convert(in, sym.type);
+  irepconverter.reference_convert(in, sym.value);
+  irepconverter.reference_convert(in, sym.location);
+
+  sym.name = irepconverter.read_string_ref(in);
+  sym.module = irepconverter.read_string_ref(in);
+  sym.base_name = irepconverter.read_string_ref(in);
+  sym.mode = irepconverter.read_string_ref(in);
+  sym.pretty_name = irepconverter.read_string_ref(in);
+
+  // obsolete: symordering
+  irepconverter.read_gb_word(in);
+
+  std::size_t flags=irepconverter.read_gb_word(in);
+
+  sym.is_weak = (flags &(1 << 16))!=0;
+  sym.is_type = (flags &(1 << 15))!=0;
+  sym.is_property = (flags &(1 << 14))!=0;
+  sym.is_macro = (flags &(1 << 13))!=0;
+  sym.is_exported = (flags &(1 << 12))!=0;
+  sym.is_input = (flags &(1 << 11))!=0;
+  sym.is_output = (flags &(1 << 10))!=0;
+  sym.is_state_var = (flags &(1 << 9))!=0;
+  sym.is_parameter = (flags &(1 << 8))!=0;
+  sym.is_auxiliary = (flags &(1 << 7))!=0;
+  // sym.binding = (flags &(1 << 6))!=0;
+  sym.is_lvalue = (flags &(1 << 5))!=0;
+  sym.is_static_lifetime = (flags &(1 << 4))!=0;
+  sym.is_thread_local = (flags &(1 << 3))!=0;
+  sym.is_file_local = (flags &(1 << 2))!=0;
+  sym.is_extern = (flags &(1 << 1))!=0;
+  sym.is_volatile = (flags &1)!=0;
+}
+
+void read_bin_goto_function_body(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  goto_functionst::goto_functiont &f)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t i=0; i<ins_count; i++)
+  {
+    goto_programt::targett itarget = f.body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
+
+    irepconverter.reference_convert(in, instruction.code);
+    instruction.function = irepconverter.read_string_ref(in);
+    irepconverter.reference_convert(in, instruction.source_location);
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard.make_nil();
+    irepconverter.reference_convert(in, instruction.guard);
+    irepconverter.read_string_ref(in); // former event
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label=="__CPROVER_HIDE")
+        hidden=true;
+      // The above info is normally in the type of the goto_functiont object,
+      // which should likely be stored in the binary.
+    }
+  }
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      assert(entry!=rev_target_map.end());
+      ins->targets.push_back(entry->second);
+    }
+  }
+
+  f.body.update();
+
+  if(hidden)
+    f.make_hidden();
+}
+
+/// reads the symbols of a goto binary, making sure there is a function for
+/// each function symbol
+static void read_bin_goto_symbols(
   std::istream &in,
-  const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler,
   irep_serializationt &irepconverter)
 {
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
@@ -36,39 +149,7 @@ bool read_bin_goto_object_v3(
   for(std::size_t i=0; i<count; i++)
   {
     symbolt sym;
-
-    irepconverter.reference_convert(in, sym.type);
-    irepconverter.reference_convert(in, sym.value);
-    irepconverter.reference_convert(in, sym.location);
-
-    sym.name = irepconverter.read_string_ref(in);
-    sym.module = irepconverter.read_string_ref(in);
-    sym.base_name = irepconverter.read_string_ref(in);
-    sym.mode = irepconverter.read_string_ref(in);
-    sym.pretty_name = irepconverter.read_string_ref(in);
-
-    // obsolete: symordering
-    irepconverter.read_gb_word(in);
-
-    std::size_t flags=irepconverter.read_gb_word(in);
-
-    sym.is_weak = (flags &(1 << 16))!=0;
-    sym.is_type = (flags &(1 << 15))!=0;
-    sym.is_property = (flags &(1 << 14))!=0;
-    sym.is_macro = (flags &(1 << 13))!=0;
-    sym.is_exported = (flags &(1 << 12))!=0;
-    sym.is_input = (flags &(1 << 11))!=0;
-    sym.is_output = (flags &(1 << 10))!=0;
-    sym.is_state_var = (flags &(1 << 9))!=0;
-    sym.is_parameter = (flags &(1 << 8))!=0;
-    sym.is_auxiliary = (flags &(1 << 7))!=0;
-    // sym.binding = (flags &(1 << 6))!=0;
-    sym.is_lvalue = (flags &(1 << 5))!=0;
-    sym.is_static_lifetime = (flags &(1 << 4))!=0;
-    sym.is_thread_local = (flags &(1 << 3))!=0;
-    sym.is_file_local = (flags &(1 << 2))!=0;
-    sym.is_extern = (flags &(1 << 1))!=0;
-    sym.is_volatile = (flags &1)!=0;
+    read_bin_goto_symbol(in, irepconverter, sym);
 
     if(!sym.is_type && sym.type.id()==ID_code)
     {
@@ -80,82 +161,76 @@ bool read_bin_goto_object_v3(
 
     symbol_table.add(sym);
   }
+}
 
-  count=irepconverter.read_gb_word(in); // # of functions
+/// read goto binary format v3
+/// \par parameters: input stream, symbol_table, functions
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v3(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  irep_serializationt &irepconverter)
+{
+  read_bin_goto_symbols(in, symbol_table, functions, irepconverter);
+
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
 
   for(std::size_t i=0; i<count; i++)
   {
     irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
+    read_bin_goto_function_body(
+      in, irepconverter, functions.function_map[fname]);
+  }
 
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+  functions.compute_location_numbers();
 
-    bool hidden=false;
+  return false;
+}
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t i=0; i<ins_count; i++)
-    {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      irepconverter.reference_convert(in, instruction.code);
-      instruction.function = irepconverter.read_string_ref(in);
-      irepconverter.reference_convert(in, instruction.source_location);
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard.make_nil();
-      irepconverter.reference_convert(in, instruction.guard);
-      irepconverter.read_string_ref(in); // former event
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
-      {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label=="__CPROVER_HIDE")
-          hidden=true;
-        // The above info is normally in the type of the goto_functiont object,
-        // which should likely be stored in the binary.
-      }
-    }
+/// read goto binary format v4, which is v3 preceded by an index, and with
+/// each section serialized on its own; see write_goto_binary_v4
+/// \par parameters: input stream, symbol_table, functions
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v4(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  irep_serializationt &irepconverter)
+{
+  // the sections follow in the order of the index, so we only need the
+  // function names from it
+  irepconverter.read_gb_word(in); // size of the symbol table
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
-    {
-      goto_programt::targett ins = tit->first;
+  std::vector<irep_idt> fnames;
+  fnames.reserve(count);
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
-      {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        assert(entry!=rev_target_map.end());
-        ins->targets.push_back(entry->second);
-      }
-    }
+  for(std::size_t i=0; i<count; i++)
+  {
+    fnames.push_back(irepconverter.read_gb_string(in));
+    irepconverter.read_gb_word(in); // size of the body
+  }
 
-    f.body.update();
+  irepconverter.clear();
+  read_bin_goto_symbols(in, symbol_table, functions, irepconverter);
 
-    if(hidden)
-      f.make_hidden();
+  for(const auto &fname : fnames)
+  {
+    irepconverter.clear();
+    read_bin_goto_function_body(
+      in, irepconverter, functions.function_map[fname]);
+  }
+
+  if(!in)
+  {
+    messaget message(message_handler);
+    message.error() << "`" << filename << "' is truncated" << messaget::eom;
+    return true;
   }
 
   functions.compute_location_numbers();
@@ -235,6 +310,12 @@ bool read_bin_goto_object(
                                      irepconverter);
       break;
 
+    case 4:
+      return read_bin_goto_object_v4(in, filename,
+                                     symbol_table, functions,
+                                     message_handler,
+                                     irepconverter);
+
     default:
       message.error() <<
           "The input was compiled with an unsupported version of "
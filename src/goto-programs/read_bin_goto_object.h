@@ -17,9 +17,12 @@ Date: May 2007
 #include <iosfwd>
 #include <string>
 
+#include "goto_functions.h"
+
 class symbol_tablet;
-class goto_functionst;
+class symbolt;
 class message_handlert;
+class irep_serializationt;
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -28,4 +31,17 @@ bool read_bin_goto_object(
   goto_functionst &goto_functions,
   message_handlert &message_handler);
 
+/// Reads a symbol as written to goto binaries since version 2
+void read_bin_goto_symbol(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  symbolt &sym);
+
+/// Reads the instructions of a function body as written to goto binaries
+/// since version 2
+void read_bin_goto_function_body(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  goto_functionst::goto_functiont &f);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
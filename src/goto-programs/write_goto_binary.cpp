@@ -12,6 +12,8 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 #include <util/message.h>
 #include <util/irep_serialization.h>
@@ -19,7 +21,83 @@ Author: CM Wintersteiger
 
 #include <goto-programs/goto_model.h>
 
-/// Writes a goto program to disc, using goto binary format ver 2
+/// Writes a symbol in the format used since goto binary format ver 2
+static void write_bin_goto_symbol(
+  std::ostream &out,
+  const symbolt &sym,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, symbols are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  irepconverter.reference_convert(sym.type, out);
+  irepconverter.reference_convert(sym.value, out);
+  irepconverter.reference_convert(sym.location, out);
+
+  irepconverter.write_string_ref(out, sym.name);
+  irepconverter.write_string_ref(out, sym.module);
+  irepconverter.write_string_ref(out, sym.base_name);
+  irepconverter.write_string_ref(out, sym.mode);
+  irepconverter.write_string_ref(out, sym.pretty_name);
+
+  write_gb_word(out, 0); // old: sym.ordering
+
+  unsigned flags=0;
+  flags = (flags << 1) | static_cast<int>(sym.is_weak);
+  flags = (flags << 1) | static_cast<int>(sym.is_type);
+  flags = (flags << 1) | static_cast<int>(sym.is_property);
+  flags = (flags << 1) | static_cast<int>(sym.is_macro);
+  flags = (flags << 1) | static_cast<int>(sym.is_exported);
+  flags = (flags << 1) | static_cast<int>(sym.is_input);
+  flags = (flags << 1) | static_cast<int>(sym.is_output);
+  flags = (flags << 1) | static_cast<int>(sym.is_state_var);
+  flags = (flags << 1) | static_cast<int>(sym.is_parameter);
+  flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
+  flags = (flags << 1) | static_cast<int>(false); // sym.binding;
+  flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
+  flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
+  flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_file_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_extern);
+  flags = (flags << 1) | static_cast<int>(sym.is_volatile);
+
+  write_gb_word(out, flags);
+}
+
+/// Writes the instructions of a function body in the format used since goto
+/// binary format ver 2
+static void write_bin_goto_function_body(
+  std::ostream &out,
+  const goto_functionst::goto_functiont &function,
+  irep_serializationt &irepconverter)
+{
+  write_gb_word(out, function.body.instructions.size()); // # instructions
+
+  forall_goto_program_instructions(i_it, function.body)
+  {
+    const goto_programt::instructiont &instruction = *i_it;
+
+    irepconverter.reference_convert(instruction.code, out);
+    irepconverter.write_string_ref(out, instruction.function);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    irepconverter.write_string_ref(out, irep_idt()); // former event
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
+
+/// Writes a goto program to disc, using goto binary format ver 3
 bool write_goto_binary_v3(
   std::ostream &out,
   const symbol_tablet &symbol_table,
@@ -31,45 +109,7 @@ bool write_goto_binary_v3(
   write_gb_word(out, symbol_table.symbols.size());
 
   forall_symbols(it, symbol_table.symbols)
-  {
-    // Since version 2, symbols are not converted to ireps,
-    // instead they are saved in a custom binary format
-
-    const symbolt &sym = it->second;
-
-    irepconverter.reference_convert(sym.type, out);
-    irepconverter.reference_convert(sym.value, out);
-    irepconverter.reference_convert(sym.location, out);
-
-    irepconverter.write_string_ref(out, sym.name);
-    irepconverter.write_string_ref(out, sym.module);
-    irepconverter.write_string_ref(out, sym.base_name);
-    irepconverter.write_string_ref(out, sym.mode);
-    irepconverter.write_string_ref(out, sym.pretty_name);
-
-    write_gb_word(out, 0); // old: sym.ordering
-
-    unsigned flags=0;
-    flags = (flags << 1) | static_cast<int>(sym.is_weak);
-    flags = (flags << 1) | static_cast<int>(sym.is_type);
-    flags = (flags << 1) | static_cast<int>(sym.is_property);
-    flags = (flags << 1) | static_cast<int>(sym.is_macro);
-    flags = (flags << 1) | static_cast<int>(sym.is_exported);
-    flags = (flags << 1) | static_cast<int>(sym.is_input);
-    flags = (flags << 1) | static_cast<int>(sym.is_output);
-    flags = (flags << 1) | static_cast<int>(sym.is_state_var);
-    flags = (flags << 1) | static_cast<int>(sym.is_parameter);
-    flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
-    flags = (flags << 1) | static_cast<int>(false); // sym.binding;
-    flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
-    flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
-    flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_file_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_extern);
-    flags = (flags << 1) | static_cast<int>(sym.is_volatile);
-
-    write_gb_word(out, flags);
-  }
+    write_bin_goto_symbol(out, it->second, irepconverter);
 
   // now write functions, but only those with body
 
@@ -84,39 +124,74 @@ bool write_goto_binary_v3(
   {
     if(fct.second.body_available())
     {
-      // Since version 2, goto functions are not converted to ireps,
-      // instead they are saved in a custom binary format
-
       write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
+      write_bin_goto_function_body(out, fct.second, irepconverter);
+    }
+  }
 
-      forall_goto_program_instructions(i_it, fct.second.body)
-      {
-        const goto_programt::instructiont &instruction = *i_it;
+  // irepconverter.output_map(f);
+  // irepconverter.output_string_map(f);
 
-        irepconverter.reference_convert(instruction.code, out);
-        irepconverter.write_string_ref(out, instruction.function);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        irepconverter.write_string_ref(out, irep_idt()); // former event
-        write_gb_word(out, instruction.target_number);
+  return false;
+}
+
+/// Writes a goto program to disc, using goto binary format ver 4. This
+/// starts with an index that gives the size of the symbol table and of each
+/// function body, which follow in this order. Each of them is serialized
+/// with a converter of its own, so that it can be decoded without reading
+/// the others.
+bool write_goto_binary_v4(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions)
+{
+  std::string symbols;
+
+  {
+    std::ostringstream section;
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc);
+
+    write_gb_word(section, symbol_table.symbols.size());
+
+    forall_symbols(it, symbol_table.symbols)
+      write_bin_goto_symbol(section, it->second, irepconverter);
+
+    symbols=section.str();
+  }
 
-        write_gb_word(out, instruction.targets.size());
+  // only functions with body
+  std::vector<std::pair<irep_idt, std::string>> bodies;
 
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(fct.second.body_available())
+    {
+      std::ostringstream section;
+      irep_serializationt::ireps_containert irepc;
+      irep_serializationt irepconverter(irepc);
 
-        write_gb_word(out, instruction.labels.size());
+      write_bin_goto_function_body(section, fct.second, irepconverter);
 
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
-      }
+      bodies.emplace_back(fct.first, section.str());
     }
   }
 
-  // irepconverter.output_map(f);
-  // irepconverter.output_string_map(f);
+  // the index
+  write_gb_word(out, symbols.size());
+  write_gb_word(out, bodies.size());
+
+  for(const auto &body : bodies)
+  {
+    write_gb_string(out, id2string(body.first)); // name
+    write_gb_word(out, body.second.size());
+  }
+
+  // the sections
+  out << symbols;
+
+  for(const auto &body : bodies)
+    out << body.second;
 
   return false;
 }
@@ -160,6 +235,9 @@ bool write_goto_binary(
     return write_goto_binary_v3(
       out, symbol_table, goto_functions, irepconverter);
 
+  case 4:
+    return write_goto_binary_v4(out, symbol_table, goto_functions);
+
   default:
     throw "unknown goto binary version";
   }
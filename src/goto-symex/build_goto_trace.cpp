@@ -264,7 +264,7 @@ void build_goto_trace(
 
     goto_trace_step.thread_nr=SSA_step.source.thread_nr;
     goto_trace_step.pc=SSA_step.source.pc;
-    goto_trace_step.comment=SSA_step.comment;
+    goto_trace_step.comment=id2string(SSA_step.comment);
     if(SSA_step.ssa_lhs.is_not_nil())
       goto_trace_step.lhs_object=
         ssa_exprt(SSA_step.ssa_lhs.get_original_expr());
@@ -13,9 +13,18 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/simplify_expr.h>
 
+#include <pointer-analysis/value_set_dereference.h>
+
 unsigned goto_symext::nondet_count=0;
 unsigned goto_symext::dynamic_counter=0;
 
+void goto_symext::reset_counters()
+{
+  nondet_count=0;
+  dynamic_counter=0;
+  value_set_dereferencet::reset_invalid_counter();
+}
+
 void goto_symext::do_simplify(exprt &expr)
 {
   if(options.get_bool_option("simplify"))
@@ -74,12 +74,13 @@ void goto_symex_statet::level1t::operator()(ssa_exprt &ssa_expr)
 
   const irep_idt l0_name=ssa_expr.get_l1_object_identifier();
 
-  current_namest::const_iterator it=current_names.find(l0_name);
-  if(it==current_names.end())
+  current_namest::const_find_type entry=
+    as_const(&current_names)->find(l0_name);
+  if(!entry.second)
     return;
 
   // rename!
-  ssa_expr.set_level_1(it->second.second);
+  ssa_expr.set_level_1(entry.first.second);
 }
 
 /// This function determines what expressions are to be propagated as
@@ -334,8 +335,7 @@ void goto_symex_statet::assignment(
   #endif
 
   // do the l2 renaming
-  if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-    level2.current_names[l1_identifier]=std::make_pair(lhs, 0);
+  level2.current_names.insert(l1_identifier, std::make_pair(lhs, 0));
   level2.increase_counter(l1_identifier);
   set_ssa_indices(lhs, ns, L2);
 
@@ -378,10 +378,10 @@ void goto_symex_statet::propagationt::operator()(exprt &expr)
 {
   if(expr.id()==ID_symbol)
   {
-    valuest::const_iterator it=
-      values.find(expr.get(ID_identifier));
-    if(it!=values.end())
-      expr=it->second;
+    valuest::const_find_type entry=
+      as_const(&values)->find(expr.get(ID_identifier));
+    if(entry.second)
+      expr=entry.first;
   }
   else if(expr.id()==ID_address_of)
   {
@@ -464,11 +464,11 @@ void goto_symex_statet::rename(
       {
         // We also consider propagation if we go up to L2.
         // L1 identifiers are used for propagation!
-        propagationt::valuest::const_iterator p_it=
-          propagation.values.find(ssa.get_identifier());
+        propagationt::valuest::const_find_type p_entry=
+          as_const(&propagation.values)->find(ssa.get_identifier());
 
-        if(p_it!=propagation.values.end())
-          expr=p_it->second; // already L2
+        if(p_entry.second)
+          expr=p_entry.first; // already L2
         else
           set_ssa_indices(ssa, ns, L2);
       }
@@ -604,8 +604,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
 
     if(a_s_read.second.empty())
     {
-      if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-        level2.current_names[l1_identifier]=std::make_pair(ssa_l1, 0);
+      level2.current_names.insert(l1_identifier, std::make_pair(ssa_l1, 0));
       level2.increase_counter(l1_identifier);
       a_s_read.first=level2.current_count(l1_identifier);
     }
@@ -642,8 +641,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
     return true;
   }
 
-  if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-    level2.current_names[l1_identifier]=std::make_pair(ssa_l1, 0);
+  level2.current_names.insert(l1_identifier, std::make_pair(ssa_l1, 0));
 
   // No event and no fresh index, but avoid constant propagation
   if(!record_events)
@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/std_expr.h>
 #include <util/ssa_expr.h>
 #include <util/make_unique.h>
+#include <util/sharing_map.h>
 
 #include <pointer-analysis/value_set.h>
 #include <goto-programs/goto_functions.h>
@@ -68,28 +69,34 @@ public:
   {
     virtual ~renaming_levelt() { }
 
-    typedef std::map<irep_idt, std::pair<ssa_exprt, unsigned> > current_namest;
+    // Copies of a sharing map share all parts that neither copy has
+    // changed, which keeps saving states at branches and function calls
+    // cheap. Use the const interface for lookups, the non-const one
+    // unshares the path to the key.
+    typedef sharing_mapt<
+      irep_idt,
+      std::pair<ssa_exprt, unsigned>,
+      irep_id_hash> current_namest;
     current_namest current_names;
 
     unsigned current_count(const irep_idt &identifier) const
     {
-      current_namest::const_iterator it=
-        current_names.find(identifier);
-      return it==current_names.end()?0:it->second.second;
+      current_namest::const_find_type entry=current_names.find(identifier);
+      return entry.second?entry.first.second:0;
     }
 
     void increase_counter(const irep_idt &identifier)
     {
-      PRECONDITION(current_names.find(identifier) != current_names.end());
-      ++current_names[identifier].second;
+      PRECONDITION(current_names.has_key(identifier));
+      ++current_names.find(identifier, tvt(true)).first.second;
     }
 
     void get_variables(std::unordered_set<ssa_exprt, irep_hash> &vars) const
     {
-      for(current_namest::const_iterator it=current_names.begin();
-          it!=current_names.end();
-          it++)
-        vars.insert(it->second.first);
+      current_namest::viewt view;
+      current_names.get_view(view);
+      for(const auto &entry : view)
+        vars.insert(entry.second.first);
     }
   };
 
@@ -115,23 +122,11 @@ public:
 
     void restore_from(const current_namest &other)
     {
-      current_namest::iterator it=current_names.begin();
-      for(current_namest::const_iterator
-          ito=other.begin();
-          ito!=other.end();
-          ++ito)
-      {
-        while(it!=current_names.end() && it->first<ito->first)
-          ++it;
-        if(it==current_names.end() || ito->first<it->first)
-          current_names.insert(it, *ito);
-        else if(it!=current_names.end())
-        {
-          PRECONDITION(it->first == ito->first);
-          it->second=ito->second;
-          ++it;
-        }
-      }
+      // entries still shared with other are up to date already
+      current_namest::delta_viewt delta_view;
+      other.get_delta_view(current_names, delta_view, false);
+      for(const auto &item : delta_view)
+        current_names[item.k]=item.m;
     }
 
     level1t() { }
@@ -150,7 +145,7 @@ public:
   class propagationt
   {
   public:
-    typedef std::map<irep_idt, exprt> valuest;
+    typedef sharing_mapt<irep_idt, exprt, irep_id_hash> valuest;
     valuest values;
     void operator()(exprt &expr);
 
@@ -226,18 +221,38 @@ public:
     void level2_get_variables(
       std::unordered_set<ssa_exprt, irep_hash> &vars) const
     {
-      for(level2t::current_namest::const_iterator
-          it=level2_current_names.begin();
-          it!=level2_current_names.end();
-          it++)
-        vars.insert(it->second.first);
+      level2t::current_namest::viewt view;
+      level2_current_names.get_view(view);
+      for(const auto &entry : view)
+        vars.insert(entry.second.first);
+    }
+
+    /// Adds to \p vars the variables whose L2 renaming may differ between
+    /// this state and \p level2, skipping the parts of the renaming the
+    /// two still share
+    void level2_get_changed_variables(
+      const level2t &level2,
+      std::unordered_set<ssa_exprt, irep_hash> &vars) const
+    {
+      level2t::current_namest::delta_viewt delta_view;
+      level2_current_names.get_delta_view(
+        level2.current_names, delta_view, false);
+      for(const auto &item : delta_view)
+        vars.insert(item.m.first);
+
+      delta_view.clear();
+      level2.current_names.get_delta_view(
+        level2_current_names, delta_view, false);
+      for(const auto &item : delta_view)
+        if(!item.in_both)
+          vars.insert(item.m.first);
     }
 
     unsigned level2_current_count(const irep_idt &identifier) const
     {
-      level2t::current_namest::const_iterator it=
+      level2t::current_namest::const_find_type entry=
         level2_current_names.find(identifier);
-      return it==level2_current_names.end()?0:it->second.second;
+      return entry.second?entry.first.second:0;
     }
   };
 
@@ -0,0 +1,372 @@
+/*******************************************************************\
+
+Module: Path Storage
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storage of symbolic execution paths to resume, and strategies for
+/// choosing which of them to resume next
+
+#include "path_storage.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include <util/make_unique.h>
+
+path_storaget::patht &path_storaget::peek()
+{
+  PRECONDITION(!paths.empty());
+  last_peeked=select();
+  return *last_peeked;
+}
+
+void path_storaget::pop()
+{
+  PRECONDITION(last_peeked!=paths.end());
+  paths.erase(last_peeked);
+  last_peeked=paths.end();
+}
+
+void path_storaget::push(const patht &path)
+{
+  paths.emplace_back(path);
+}
+
+void path_storaget::retain(std::size_t n)
+{
+  PRECONDITION(n<paths.size());
+
+  // the paths the strategy would resume before the n-th one
+  for(std::size_t i=0; i<n; i++)
+    paths.erase(select());
+
+  paths.splice(paths.begin(), paths, select());
+  paths.erase(std::next(paths.begin()), paths.end());
+  last_peeked=paths.end();
+}
+
+path_storaget::pathst::iterator path_lifot::select()
+{
+  return std::prev(paths.end());
+}
+
+path_storaget::pathst::iterator path_fifot::select()
+{
+  return paths.begin();
+}
+
+path_storaget::pathst::iterator path_randomt::select()
+{
+  std::uniform_int_distribution<std::size_t> choice(0, paths.size()-1);
+  return std::next(paths.begin(), choice(generator));
+}
+
+void path_random_restartt::path_explored(
+  const symex_target_equationt &equation)
+{
+  if(++explored==next_restart)
+  {
+    restart_pending=true;
+    next_restart*=2;
+  }
+}
+
+path_storaget::pathst::iterator path_random_restartt::select()
+{
+  if(!restart_pending)
+    return std::prev(paths.end());
+
+  restart_pending=false;
+  std::uniform_int_distribution<std::size_t> choice(0, paths.size()-1);
+  return std::next(paths.begin(), choice(generator));
+}
+
+static const std::size_t infinite_distance=
+  std::numeric_limits<std::size_t>::max();
+
+/// \return one more than \p distance, unless \p distance is infinite
+static std::size_t one_more(std::size_t distance)
+{
+  return distance==infinite_distance ? distance : distance+1;
+}
+
+static std::size_t add_distances(std::size_t a, std::size_t b)
+{
+  if(a==infinite_distance || b==infinite_distance)
+    return infinite_distance;
+  return a+b;
+}
+
+void path_nearest_propertyt::path_explored(
+  const symex_target_equationt &equation)
+{
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(step.is_assert() &&
+       step.source.pc->is_assert() &&
+       reached_assertions.insert(step.source.pc->location_number).second)
+    {
+      distances_valid=false;
+    }
+  }
+}
+
+/// Computes, for each instruction, the length of the shortest path in the
+/// interprocedural control-flow graph to an assertion not yet reached, and
+/// to the end of its function. This is a backwards fixed point; a function
+/// call may either step over the call or enter the callee.
+void path_nearest_propertyt::compute_distances()
+{
+  std::size_t number_of_locations=0;
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      number_of_locations=
+        std::max(number_of_locations, std::size_t(i_it->location_number+1));
+
+  distance.assign(number_of_locations, infinite_distance);
+  distance_to_return.assign(number_of_locations, infinite_distance);
+
+  std::map<irep_idt, std::size_t> entry_distance;
+
+  bool changed=true;
+  while(changed)
+  {
+    changed=false;
+
+    forall_goto_functions(f_it, goto_functions)
+    {
+      const goto_programt &body=f_it->second.body;
+      if(body.instructions.empty())
+        continue;
+
+      // visit backwards, which is the direction in which distances travel
+      for(goto_programt::const_targett i_it=body.instructions.end();
+          i_it!=body.instructions.begin();
+         ) // no ++i_it
+      {
+        --i_it;
+
+        std::size_t d=
+          i_it->is_assert() &&
+          reached_assertions.find(i_it->location_number)==
+            reached_assertions.end() ? 0 : infinite_distance;
+        std::size_t r=i_it->is_end_function() ? 0 : infinite_distance;
+
+        for(const auto &successor : body.get_successors(i_it))
+        {
+          d=std::min(d, one_more(distance[successor->location_number]));
+          r=std::min(
+            r, one_more(distance_to_return[successor->location_number]));
+        }
+
+        if(i_it->is_function_call())
+        {
+          const exprt &function=to_code_function_call(i_it->code).function();
+          if(function.id()==ID_symbol)
+          {
+            auto e_it=entry_distance.find(
+              to_symbol_expr(function).get_identifier());
+            if(e_it!=entry_distance.end())
+              d=std::min(d, one_more(e_it->second));
+          }
+        }
+
+        if(d<distance[i_it->location_number])
+        {
+          distance[i_it->location_number]=d;
+          changed=true;
+        }
+
+        if(r<distance_to_return[i_it->location_number])
+        {
+          distance_to_return[i_it->location_number]=r;
+          changed=true;
+        }
+      }
+
+      entry_distance[f_it->first]=
+        distance[body.instructions.begin()->location_number];
+    }
+  }
+
+  distances_valid=true;
+}
+
+/// \return distance from the point at which \p state resumes to the nearest
+///   unreached assertion, either in the current function or after returning
+///   to one of the callers on the call stack
+std::size_t path_nearest_propertyt::distance_of(
+  const goto_symex_statet &state) const
+{
+  const auto lookup=[](
+    const std::vector<std::size_t> &table,
+    goto_programt::const_targett pc)
+  {
+    return pc->location_number<table.size() ?
+      table[pc->location_number] : infinite_distance;
+  };
+
+  const goto_programt::const_targett pc=
+    state.has_saved_target ? state.saved_target : state.source.pc;
+
+  std::size_t result=lookup(distance, pc);
+  std::size_t to_caller=lookup(distance_to_return, pc);
+
+  // the bottom frame has no caller
+  const goto_symex_statet::call_stackt &call_stack=state.call_stack();
+  for(std::size_t i=call_stack.size(); i>1; i--)
+  {
+    const goto_programt::const_targett return_to=
+      std::next(call_stack[i-1].calling_location.pc);
+
+    to_caller=one_more(to_caller);
+    result=std::min(
+      result, add_distances(to_caller, lookup(distance, return_to)));
+    to_caller=add_distances(to_caller, lookup(distance_to_return, return_to));
+  }
+
+  return result;
+}
+
+path_storaget::pathst::iterator path_nearest_propertyt::select()
+{
+  if(!distances_valid)
+    compute_distances();
+
+  pathst::iterator best=paths.begin();
+  std::size_t best_distance=distance_of(best->state);
+
+  for(pathst::iterator it=std::next(best); it!=paths.end(); it++)
+  {
+    const std::size_t d=distance_of(it->state);
+    if(d<=best_distance)
+    {
+      best=it;
+      best_distance=d;
+    }
+  }
+
+  return best;
+}
+
+void path_least_coveredt::path_explored(
+  const symex_target_equationt &equation)
+{
+  std::set<unsigned> executed;
+
+  for(const auto &step : equation.SSA_steps)
+    executed.insert(step.source.pc->location_number);
+
+  for(const auto &location : executed)
+    ++coverage[location];
+}
+
+path_storaget::pathst::iterator path_least_coveredt::select()
+{
+  const auto coverage_of=[this](const patht &path)
+  {
+    const goto_programt::const_targett pc=
+      path.state.has_saved_target ?
+        path.state.saved_target : path.state.source.pc;
+    auto c_it=coverage.find(pc->location_number);
+    return c_it==coverage.end() ? 0 : c_it->second;
+  };
+
+  pathst::iterator best=paths.begin();
+  std::size_t best_coverage=coverage_of(*best);
+
+  for(pathst::iterator it=std::next(best); it!=paths.end(); it++)
+  {
+    const std::size_t c=coverage_of(*it);
+    if(c<=best_coverage)
+    {
+      best=it;
+      best_coverage=c;
+    }
+  }
+
+  return best;
+}
+
+// The strategies available on the command line. The description is shown
+// by --show-symex-strategies.
+static const std::vector<std::pair<std::string, std::string>> strategies=
+{
+  { "fifo",
+    "resume the path that was saved first (breadth-first)" },
+  { "lifo",
+    "resume the path that was saved last (depth-first)" },
+  { "random",
+    "resume a randomly chosen path (with a fixed seed)" },
+  { "random-restart",
+    "resume the path that was saved last, but restart\n"
+    "from a randomly chosen path after 4, 8, 16, ...\n"
+    "explored paths" },
+  { "nearest-property",
+    "resume the path closest to an assertion that\n"
+    "has not been reached yet" },
+  { "least-covered",
+    "resume the path whose next instruction has been\n"
+    "executed by the fewest explored paths" }
+};
+
+std::string show_path_strategies()
+{
+  std::stringstream ss;
+
+  for(const auto &strategy : strategies)
+  {
+    std::string description=strategy.second;
+    std::string::size_type pos;
+    while((pos=description.find('\n'))!=std::string::npos)
+      description.replace(pos, 1, "\n" + std::string(20, ' '));
+
+    ss << strategy.first
+       << std::string(20-std::min<std::size_t>(strategy.first.size(), 19), ' ')
+       << description << '\n';
+  }
+
+  return ss.str();
+}
+
+bool is_valid_path_strategy(const std::string &strategy)
+{
+  return std::any_of(
+    strategies.begin(),
+    strategies.end(),
+    [&strategy](const std::pair<std::string, std::string> &s)
+    {
+      return s.first==strategy;
+    });
+}
+
+std::string default_path_strategy()
+{
+  return "fifo";
+}
+
+std::unique_ptr<path_storaget> get_path_strategy(
+  const std::string &strategy,
+  const goto_functionst &goto_functions)
+{
+  if(strategy=="lifo")
+    return util_make_unique<path_lifot>();
+  else if(strategy=="random")
+    return util_make_unique<path_randomt>();
+  else if(strategy=="random-restart")
+    return util_make_unique<path_random_restartt>();
+  else if(strategy=="nearest-property")
+    return util_make_unique<path_nearest_propertyt>(goto_functions);
+  else if(strategy=="least-covered")
+    return util_make_unique<path_least_coveredt>();
+
+  INVARIANT(
+    strategy.empty() || strategy==default_path_strategy(),
+    "unknown path strategy " + strategy);
+  return util_make_unique<path_fifot>();
+}
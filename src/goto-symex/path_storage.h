@@ -0,0 +1,240 @@
+/*******************************************************************\
+
+Module: Path Storage
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storage of symbolic execution paths to resume, and strategies for
+/// choosing which of them to resume next
+
+#ifndef CPROVER_GOTO_SYMEX_PATH_STORAGE_H
+#define CPROVER_GOTO_SYMEX_PATH_STORAGE_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <goto-programs/goto_functions.h>
+
+#include "goto_symex_state.h"
+#include "symex_target_equation.h"
+
+/// \brief Storage for symbolic execution paths to be resumed later
+///
+/// When doing path exploration (`--paths`), symbolic execution saves the
+/// state at each branch point whose other side it did not take. Subclasses
+/// of this class decide in which order the saved paths are resumed.
+class path_storaget
+{
+public:
+  /// \brief Information saved at a conditional goto to resume execution
+  struct patht
+  {
+    symex_target_equationt equation;
+    goto_symex_statet state;
+
+    explicit patht(
+      const symex_target_equationt &e,
+      const goto_symex_statet &s)
+      : equation(e), state(s, &equation)
+    {
+    }
+
+    explicit patht(const patht &other)
+      : equation(other.equation), state(other.state, &equation)
+    {
+    }
+  };
+
+  path_storaget() : last_peeked(paths.end())
+  {
+  }
+
+  virtual ~path_storaget() = default;
+
+  /// \brief Reference to the next path to resume
+  ///
+  /// The reference stays valid, and the next call to pop() removes this
+  /// path, even if further paths are pushed in between.
+  patht &peek();
+
+  /// \brief Remove the path that was last returned by peek()
+  void pop();
+
+  /// \brief Save a path to be resumed later
+  void push(const patht &path);
+
+  std::size_t size() const
+  {
+    return paths.size();
+  }
+
+  bool empty() const
+  {
+    return paths.empty();
+  }
+
+  void clear()
+  {
+    paths.clear();
+    last_peeked = paths.end();
+  }
+
+  /// \brief Drop all saved paths except the \p n-th one, counting in the
+  ///   order in which the strategy would resume the paths (from 0)
+  void retain(std::size_t n);
+
+  /// \brief Notification that symbolic execution of a path has finished,
+  ///   with \p equation holding all steps executed along that path
+  virtual void path_explored(const symex_target_equationt &equation)
+  {
+  }
+
+protected:
+  typedef std::list<patht> pathst;
+
+  /// Saved paths, in the order in which they were pushed
+  pathst paths;
+
+  /// \brief Choose the path to resume next among the non-empty `paths`
+  virtual pathst::iterator select() = 0;
+
+private:
+  pathst::iterator last_peeked;
+};
+
+/// \brief Depth-first exploration: resume the most recently saved path
+class path_lifot : public path_storaget
+{
+protected:
+  pathst::iterator select() override;
+};
+
+/// \brief Breadth-first exploration: resume the least recently saved path
+class path_fifot : public path_storaget
+{
+protected:
+  pathst::iterator select() override;
+};
+
+/// \brief Resume a saved path chosen uniformly at random
+///
+/// The generator is seeded with a fixed value, so that runs are repeatable.
+class path_randomt : public path_storaget
+{
+public:
+  path_randomt() : generator(0)
+  {
+  }
+
+protected:
+  pathst::iterator select() override;
+
+private:
+  std::mt19937 generator;
+};
+
+/// \brief Depth-first exploration that restarts from a saved path chosen
+///   uniformly at random after 4, 8, 16, ... explored paths
+///
+/// Between restarts, the most recently saved path is resumed, so that each
+/// restart descends into a different region of the program. The generator
+/// is seeded with a fixed value, so that runs are repeatable.
+class path_random_restartt : public path_storaget
+{
+public:
+  path_random_restartt()
+    : generator(0), explored(0), next_restart(4), restart_pending(false)
+  {
+  }
+
+  void path_explored(const symex_target_equationt &equation) override;
+
+protected:
+  pathst::iterator select() override;
+
+private:
+  std::mt19937 generator;
+  std::size_t explored;
+  std::size_t next_restart;
+  bool restart_pending;
+};
+
+/// \brief Resume the saved path that is closest, in number of goto-program
+///   instructions, to an assertion that no explored path has reached yet
+///
+/// Distances are computed over the control-flow graph of all functions,
+/// taking into account calls and the return to the callers on the call
+/// stack of a saved path. Ties are broken in favour of the most recently
+/// saved path.
+class path_nearest_propertyt : public path_storaget
+{
+public:
+  explicit path_nearest_propertyt(const goto_functionst &goto_functions)
+    : goto_functions(goto_functions), distances_valid(false)
+  {
+  }
+
+  void path_explored(const symex_target_equationt &equation) override;
+
+protected:
+  pathst::iterator select() override;
+
+private:
+  const goto_functionst &goto_functions;
+
+  /// location numbers of assertions that some explored path has reached
+  std::set<unsigned> reached_assertions;
+
+  /// indexed by location number: distance to an unreached assertion
+  std::vector<std::size_t> distance;
+  /// indexed by location number: distance to the end of the function
+  std::vector<std::size_t> distance_to_return;
+  bool distances_valid;
+
+  void compute_distances();
+  std::size_t distance_of(const goto_symex_statet &state) const;
+};
+
+/// \brief Resume the saved path whose next instruction has been executed by
+///   the fewest explored paths, to steer exploration towards uncovered code
+///
+/// Ties are broken in favour of the most recently saved path.
+class path_least_coveredt : public path_storaget
+{
+public:
+  void path_explored(const symex_target_equationt &equation) override;
+
+protected:
+  pathst::iterator select() override;
+
+private:
+  /// location number -> number of explored paths executing it
+  std::map<unsigned, std::size_t> coverage;
+};
+
+/// \brief Names and descriptions of the available strategies, for display
+///   to the user
+std::string show_path_strategies();
+
+/// \brief Whether \p strategy names an available strategy
+bool is_valid_path_strategy(const std::string &strategy);
+
+/// \brief The name of the strategy used when none is given
+std::string default_path_strategy();
+
+/// \brief Construct a path storage that implements \p strategy
+/// \param strategy: name of the strategy, see show_path_strategies()
+/// \param goto_functions: the program being explored
+std::unique_ptr<path_storaget> get_path_strategy(
+  const std::string &strategy,
+  const goto_functionst &goto_functions);
+
+#endif // CPROVER_GOTO_SYMEX_PATH_STORAGE_H
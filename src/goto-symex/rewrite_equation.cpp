@@ -0,0 +1,111 @@
+/*******************************************************************\
+
+Module: Word-level Rewriting of Symex Equations
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Word-level Rewriting of Symex Equations
+
+#include "rewrite_equation.h"
+
+#include <unordered_map>
+
+#include <util/replace_symbol.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+
+#include "symex_target_equation.h"
+
+/// Applies \p replace to \p expr and simplifies the result
+/// \return true if \p expr changed
+static bool rewrite_expr(
+  const replace_symbolt &replace,
+  const namespacet &ns,
+  exprt &expr)
+{
+  if(expr.is_nil() || replace.replace(expr))
+    return false;
+
+  simplify(expr, ns);
+  return true;
+}
+
+rewrite_equation_statisticst rewrite_equation(
+  symex_target_equationt &equation,
+  const namespacet &ns)
+{
+  rewrite_equation_statisticst statistics;
+
+  // the partial order constraints of threads refer to the symbols as they
+  // are
+  if(equation.has_threads())
+    return statistics;
+
+  replace_symbolt replace;
+
+  // the symbols defined so far, by their right-hand side
+  std::unordered_map<exprt, ssa_exprt, irep_hash> defined_by;
+
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    bool changed=rewrite_expr(replace, ns, step.guard);
+
+    if(step.is_assignment())
+    {
+      if(rewrite_expr(replace, ns, step.ssa_rhs))
+      {
+        step.cond_expr=equal_exprt(step.ssa_lhs, step.ssa_rhs);
+        changed=true;
+      }
+
+      const irep_idt &identifier=step.ssa_lhs.get_identifier();
+      const exprt &rhs=step.ssa_rhs;
+
+      if(rhs.type()!=step.ssa_lhs.type())
+      {
+        // keep as is
+      }
+      else if(rhs.is_constant())
+      {
+        replace.insert(identifier, rhs);
+        statistics.constants++;
+      }
+      else if(rhs.id()==ID_symbol)
+      {
+        replace.insert(identifier, rhs);
+        statistics.copies++;
+      }
+      else if(rhs.has_operands())
+      {
+        const auto entry=defined_by.insert({rhs, step.ssa_lhs});
+
+        if(!entry.second)
+        {
+          replace.insert(identifier, entry.first->second);
+          statistics.common_subterms++;
+        }
+      }
+    }
+    else if(step.is_assume() ||
+            step.is_assert() ||
+            step.is_goto() ||
+            step.is_constraint())
+    {
+      changed|=rewrite_expr(replace, ns, step.cond_expr);
+    }
+
+    for(auto &arg : step.io_args)
+      changed|=rewrite_expr(replace, ns, arg);
+
+    if(changed)
+      statistics.rewritten_steps++;
+  }
+
+  return statistics;
+}
@@ -0,0 +1,45 @@
+/*******************************************************************\
+
+Module: Word-level Rewriting of Symex Equations
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Word-level Rewriting of Symex Equations
+
+#ifndef CPROVER_GOTO_SYMEX_REWRITE_EQUATION_H
+#define CPROVER_GOTO_SYMEX_REWRITE_EQUATION_H
+
+#include <cstddef>
+
+class namespacet;
+class symex_target_equationt;
+
+struct rewrite_equation_statisticst
+{
+  // the number of SSA symbols replaced by a constant, by another symbol,
+  // or by the symbol defined by an earlier assignment with the same rhs
+  std::size_t constants=0;
+  std::size_t copies=0;
+  std::size_t common_subterms=0;
+
+  // the number of steps whose expressions changed
+  std::size_t rewritten_steps=0;
+};
+
+/// Rewrites the expressions of all steps of \p equation at word level
+/// before they are given to a decision procedure. As every assignment
+/// constrains its left-hand side unconditionally, a symbol assigned a
+/// constant or another symbol is replaced by that, and a symbol assigned
+/// the same right-hand side as an earlier symbol is replaced by the earlier
+/// symbol. Expressions that changed are simplified, which may turn, e.g.,
+/// a multiplication into a constant. The assignments themselves are kept,
+/// so that traces still show the values of all symbols.
+/// Equations with threads are left unchanged.
+rewrite_equation_statisticst rewrite_equation(
+  symex_target_equationt &equation,
+  const namespacet &ns);
+
+#endif // CPROVER_GOTO_SYMEX_REWRITE_EQUATION_H
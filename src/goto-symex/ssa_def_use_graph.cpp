@@ -0,0 +1,160 @@
+/*******************************************************************\
+
+Module: Def-Use Graph of Symex Equations
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Def-Use Graph of Symex Equations
+
+#include "ssa_def_use_graph.h"
+
+#include <util/find_symbols.h>
+#include <util/invariant.h>
+
+ssa_def_use_grapht::ssa_def_use_grapht(symex_target_equationt &equation):
+  generation(0)
+{
+  typedef std::unordered_map<irep_idt, std::vector<nodet>, irep_id_hash>
+    definitionst;
+  definitionst definitions;
+
+  for(stept it=equation.SSA_steps.begin();
+      it!=equation.SSA_steps.end();
+      it++)
+  {
+    if(it->ignore)
+      continue;
+
+    const nodet node=steps.size();
+    steps.push_back(it);
+    node_of[&*it]=node;
+
+    if(it->is_assignment() || it->is_decl())
+      definitions[it->ssa_lhs.get_identifier()].push_back(node);
+    else if(it->is_assume() || it->is_constraint())
+      assumptions.push_back(node);
+  }
+
+  uses.resize(steps.size());
+  marks.resize(steps.size(), 0);
+
+  for(nodet node=0; node<steps.size(); node++)
+  {
+    const symex_target_equationt::SSA_stept &step=*steps[node];
+
+    find_symbols_sett symbols;
+    find_symbols(step.guard, symbols);
+
+    if(step.is_assignment())
+      find_symbols(step.ssa_rhs, symbols);
+    else if(step.is_assert() ||
+            step.is_assume() ||
+            step.is_goto() ||
+            step.is_constraint())
+      find_symbols(step.cond_expr, symbols);
+
+    for(const auto &arg : step.io_args)
+      find_symbols(arg, symbols);
+
+    for(const auto &identifier : symbols)
+    {
+      const definitionst::const_iterator entry=definitions.find(identifier);
+
+      if(entry!=definitions.end())
+        uses[node].insert(
+          uses[node].end(), entry->second.begin(), entry->second.end());
+    }
+  }
+}
+
+ssa_def_use_grapht::nodet ssa_def_use_grapht::get_node(stept step) const
+{
+  const auto entry=node_of.find(&*step);
+  PRECONDITION(entry!=node_of.end());
+  return entry->second;
+}
+
+/// Marks the nodes reachable from \p roots with a new generation
+/// \return the marked nodes
+std::vector<ssa_def_use_grapht::nodet> ssa_def_use_grapht::cone(
+  const std::vector<nodet> &roots)
+{
+  generation++;
+
+  std::vector<nodet> result;
+  std::vector<nodet> stack;
+
+  for(const nodet root : roots)
+  {
+    if(marks[root]!=generation)
+    {
+      marks[root]=generation;
+      stack.push_back(root);
+    }
+  }
+
+  while(!stack.empty())
+  {
+    const nodet node=stack.back();
+    stack.pop_back();
+    result.push_back(node);
+
+    for(const nodet used : uses[node])
+    {
+      if(marks[used]!=generation)
+      {
+        marks[used]=generation;
+        stack.push_back(used);
+      }
+    }
+  }
+
+  return result;
+}
+
+ssa_def_use_grapht::stepst ssa_def_use_grapht::cone_of_influence(
+  const stepst &roots)
+{
+  std::vector<nodet> root_nodes;
+  root_nodes.reserve(roots.size());
+
+  for(const auto &root : roots)
+    root_nodes.push_back(get_node(root));
+
+  stepst result;
+
+  for(const nodet node : cone(root_nodes))
+    result.push_back(steps[node]);
+
+  return result;
+}
+
+std::size_t ssa_def_use_grapht::slice(const stepst &properties)
+{
+  std::vector<nodet> roots=assumptions;
+
+  for(const auto &property : properties)
+    roots.push_back(get_node(property));
+
+  cone(roots);
+
+  std::size_t sliced=0;
+
+  for(nodet node=0; node<steps.size(); node++)
+  {
+    symex_target_equationt::SSA_stept &step=*steps[node];
+
+    if(marks[node]!=generation &&
+       !step.ignore &&
+       (step.is_assignment() || step.is_decl()))
+    {
+      step.ignore=true;
+      sliced++;
+    }
+  }
+
+  return sliced;
+}
@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Def-Use Graph of Symex Equations
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Def-Use Graph of Symex Equations
+
+#ifndef CPROVER_GOTO_SYMEX_SSA_DEF_USE_GRAPH_H
+#define CPROVER_GOTO_SYMEX_SSA_DEF_USE_GRAPH_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "symex_target_equation.h"
+
+/// Links every step of an equation to the assignments and declarations of
+/// the SSA symbols that the step reads. The graph is built once, in time
+/// linear in the size of the equation, and then answers any number of
+/// cone-of-influence queries, each in time proportional to the size of the
+/// cone. Steps that are already ignored are not part of the graph.
+class ssa_def_use_grapht
+{
+public:
+  typedef symex_target_equationt::SSA_stepst::iterator stept;
+  typedef std::vector<stept> stepst;
+
+  explicit ssa_def_use_grapht(symex_target_equationt &equation);
+
+  /// \return the steps that \p roots depend on, including the roots
+  ///   themselves, in no particular order
+  stepst cone_of_influence(const stepst &roots);
+
+  /// Marks all assignments and declarations as ignored that neither
+  /// \p properties nor any assumption or constraint depends on. The
+  /// equation then still decides whether \p properties can fail.
+  /// \return the number of steps that were newly ignored
+  std::size_t slice(const stepst &properties);
+
+protected:
+  typedef std::size_t nodet;
+
+  stepst steps;
+
+  // the nodes defining the symbols that a node reads
+  std::vector<std::vector<nodet>> uses;
+
+  std::unordered_map<const symex_target_equationt::SSA_stept *, nodet>
+    node_of;
+
+  // the assumptions and constraints, which every slice keeps
+  std::vector<nodet> assumptions;
+
+  // a node is visited by the current query if its mark is the generation
+  // of that query, which saves clearing the marks between queries
+  std::vector<unsigned> marks;
+  unsigned generation;
+
+  std::vector<nodet> cone(const std::vector<nodet> &roots);
+  nodet get_node(stept step) const;
+};
+
+#endif // CPROVER_GOTO_SYMEX_SSA_DEF_USE_GRAPH_H
@@ -329,26 +329,25 @@ void goto_symext::pop_frame(statet &state)
     state.level1.restore_from(frame.old_level1);
 
     // clear function-locals from L2 renaming
-    for(goto_symex_statet::renaming_levelt::current_namest::iterator
-        c_it=state.level2.current_names.begin();
-        c_it!=state.level2.current_names.end();
-       ) // no ++c_it
+    goto_symex_statet::renaming_levelt::current_namest::viewt view;
+    state.level2.current_names.get_view(view);
+
+    goto_symex_statet::renaming_levelt::current_namest::keyst keys;
+
+    for(const auto &entry : view)
     {
-      const irep_idt l1_o_id=c_it->second.first.get_l1_object_identifier();
+      const irep_idt l1_o_id=entry.second.first.get_l1_object_identifier();
       // could use iteration over local_objects as l1_o_id is prefix
       if(
         frame.local_objects.find(l1_o_id) == frame.local_objects.end() ||
         (state.threads.size() > 1 &&
-         state.dirty(c_it->second.first.get_object_name())))
-      {
-        ++c_it;
+         state.dirty(entry.second.first.get_object_name())))
         continue;
-      }
-      goto_symex_statet::renaming_levelt::current_namest::iterator
-        cur=c_it;
-      ++c_it;
-      state.level2.current_names.erase(cur);
+      keys.push_back(entry.first);
     }
+
+    // the view refers into the map, hence erase only now
+    state.level2.current_names.erase_all(keys, tvt(true));
   }
 
   state.pop_frame();
@@ -393,11 +392,11 @@ void goto_symext::locality(
     const irep_idt l0_name=ssa.get_identifier();
 
     // save old L1 name for popping the frame
-    statet::level1t::current_namest::const_iterator c_it=
-      state.level1.current_names.find(l0_name);
+    statet::level1t::current_namest::const_find_type c_entry=
+      as_const(&state.level1.current_names)->find(l0_name);
 
-    if(c_it!=state.level1.current_names.end())
-      frame.old_level1[l0_name]=c_it->second;
+    if(c_entry.second)
+      frame.old_level1[l0_name]=c_entry.first;
 
     // do L1 renaming -- these need not be unique, as
     // identifiers may be shared among functions
@@ -181,14 +181,14 @@ void goto_symext::symex_goto(statet &state)
     // executing from, so that goto_symex::symex_goto() knows that we've already
     // explored the branch starting from `state_pc` when it is later called at
     // this branch.
-    branch_pointt branch_point(target, state);
+    path_storaget::patht branch_point(target, state);
     branch_point.state.saved_target = new_state_pc;
     branch_point.state.has_saved_target = true;
     // `forward` tells us where the branch we're _currently_ executing is
     // pointing to; this needs to be inverted for the branch that we're saving,
     // so let its truth value for `backwards` be the same as ours for `forward`.
     branch_point.state.saved_target_is_backwards = forward;
-    branch_worklist.push_back(branch_point);
+    path_storage.push(branch_point);
     log.debug() << "Saving '" << new_state_pc->source_location << "'"
                 << log.eom;
   }
@@ -351,8 +351,7 @@ void goto_symext::phi_function(
   // go over all variables to see what changed
   std::unordered_set<ssa_exprt, irep_hash> variables;
 
-  goto_state.level2_get_variables(variables);
-  dest_state.level2.get_variables(variables);
+  goto_state.level2_get_changed_variables(dest_state.level2, variables);
 
   guardt diff_guard;
 
@@ -402,22 +401,22 @@ void goto_symext::phi_function(
     exprt goto_state_rhs=*it, dest_state_rhs=*it;
 
     {
-      goto_symex_statet::propagationt::valuest::const_iterator p_it=
+      goto_symex_statet::propagationt::valuest::const_find_type p_entry=
         goto_state.propagation.values.find(l1_identifier);
 
-      if(p_it!=goto_state.propagation.values.end())
-        goto_state_rhs=p_it->second;
+      if(p_entry.second)
+        goto_state_rhs=p_entry.first;
       else
         to_ssa_expr(goto_state_rhs).set_level_2(
           goto_state.level2_current_count(l1_identifier));
     }
 
     {
-      goto_symex_statet::propagationt::valuest::const_iterator p_it=
-        dest_state.propagation.values.find(l1_identifier);
+      goto_symex_statet::propagationt::valuest::const_find_type p_entry=
+        as_const(&dest_state.propagation.values)->find(l1_identifier);
 
-      if(p_it!=dest_state.propagation.values.end())
-        dest_state_rhs=p_it->second;
+      if(p_entry.second)
+        dest_state_rhs=p_entry.first;
       else
         to_ssa_expr(dest_state_rhs).set_level_2(
           dest_state.level2.current_count(l1_identifier));
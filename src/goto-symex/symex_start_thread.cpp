@@ -51,18 +51,25 @@ void goto_symext::symex_start_thread(statet &state)
   // create a copy of the local variables for the new thread
   statet::framet &frame=state.top();
 
-  for(goto_symex_statet::renaming_levelt::current_namest::const_iterator
-      c_it=state.level2.current_names.begin();
-      c_it!=state.level2.current_names.end();
-      ++c_it)
+  // the loop below changes the L2 renaming, which would invalidate a view
+  // into it; hence collect the expressions first
+  std::vector<ssa_exprt> l2_names;
   {
-    const irep_idt l1_o_id=c_it->second.first.get_l1_object_identifier();
+    goto_symex_statet::renaming_levelt::current_namest::viewt view;
+    state.level2.current_names.get_view(view);
+    for(const auto &entry : view)
+      l2_names.push_back(entry.second.first);
+  }
+
+  for(const ssa_exprt &l2_name : l2_names)
+  {
+    const irep_idt l1_o_id=l2_name.get_l1_object_identifier();
     // could use iteration over local_objects as l1_o_id is prefix
     if(frame.local_objects.find(l1_o_id)==frame.local_objects.end())
       continue;
 
     // get original name
-    ssa_exprt lhs(c_it->second.first.get_original_expr());
+    ssa_exprt lhs(l2_name.get_original_expr());
 
     // get L0 name for current thread
     lhs.set_level_0(t);
@@ -79,7 +86,7 @@ void goto_symext::symex_start_thread(statet &state)
     new_thread.call_stack.back().local_objects.insert(l1_name);
 
     // make copy
-    ssa_exprt rhs=c_it->second.first;
+    ssa_exprt rhs=l2_name;
 
     guardt guard;
     const bool record_events=state.record_events;
@@ -17,6 +17,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/invariant.h>
 #include <util/merge_irep.h>
+#include <util/segmented_deque.h>
 
 #include <goto-programs/goto_program.h>
 #include <goto-programs/goto_trace.h>
@@ -222,7 +223,8 @@ public:
     // for ASSUME/ASSERT/GOTO/CONSTRAINT
     exprt cond_expr;
     literalt cond_literal;
-    std::string comment;
+    // the same comment is shared by all instances of an assertion
+    irep_idt comment;
 
     // for INPUT/OUTPUT
     irep_idt format_string, io_id;
@@ -284,18 +286,15 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // Steps are stored in chunks rather than in list nodes, and iterators
+  // to them remain valid when further steps are added at either end.
+  typedef segmented_dequet<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
-    SSA_stepst::iterator it=SSA_steps.begin();
-    for(; s!=0; s--)
-    {
-      PRECONDITION(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    PRECONDITION(s<=SSA_steps.size());
+    return SSA_steps.begin()+s;
   }
 
   void output(std::ostream &out, const namespacet &ns) const;
@@ -322,11 +321,4 @@ protected:
   void merge_ireps(SSA_stept &SSA_step);
 };
 
-inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a)<&(*b);
-}
-
 #endif // CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
@@ -29,6 +29,7 @@ Author: Daniel Kroening, kroening@kroening.com
 extern unsigned long long irep_hash_cnt;
 extern unsigned long long irep_cmp_cnt;
 extern unsigned long long irep_cmp_ne_cnt;
+extern unsigned long long irep_cmp_ptr_cnt;
 #endif
 
 #ifdef _MSC_VER
@@ -49,6 +50,7 @@ int main(int argc, const char **argv)
   std::cout << "IREP_HASH_CNT=" << irep_hash_cnt << '\n';
   std::cout << "IREP_CMP_CNT=" << irep_cmp_cnt << '\n';
   std::cout << "IREP_CMP_NE_CNT=" << irep_cmp_ne_cnt << '\n';
+  std::cout << "IREP_CMP_PTR_CNT=" << irep_cmp_ptr_cnt << '\n';
   #endif
 
   return res;
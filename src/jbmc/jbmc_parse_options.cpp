@@ -45,6 +45,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_properties.h>
 
 #include <goto-symex/adjust_float_expressions.h>
+#include <goto-symex/path_storage.h>
 
 #include <goto-instrument/full_slicer.h>
 #include <goto-instrument/nondet_static.h>
@@ -99,6 +100,21 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     exit(1); // should contemplate EX_USAGE from sysexits.h
   }
 
+  if(cmdline.isset("paths"))
+    options.set_option("paths", true);
+
+  if(cmdline.isset("paths-strategy"))
+  {
+    const std::string strategy=cmdline.get_value("paths-strategy");
+    if(!is_valid_path_strategy(strategy))
+    {
+      error() << "unknown strategy `" << strategy
+              << "' -- use --show-symex-strategies for a list" << eom;
+      exit(1); // should contemplate EX_USAGE from sysexits.h
+    }
+    options.set_option("paths-strategy", strategy);
+  }
+
   if(cmdline.isset("program-only"))
     options.set_option("program-only", true);
 
@@ -136,6 +152,29 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
+  if(cmdline.isset("jobs"))
+    options.set_option("jobs", cmdline.get_value("jobs"));
+
+  if(cmdline.isset("incremental-unwind"))
+  {
+    // each bound only checks whether some property fails, and the
+    // equation is converted to the solver bound by bound
+    if(cmdline.isset("paths") ||
+       cmdline.isset("cover") ||
+       cmdline.isset("localize-faults") ||
+       cmdline.isset("dimacs") ||
+       cmdline.isset("outfile") ||
+       cmdline.isset("show-vcc") ||
+       cmdline.isset("program-only"))
+    {
+      error() << "--incremental-unwind cannot be used with --paths, "
+              << "--cover, --localize-faults, --dimacs, --outfile, "
+              << "--show-vcc or --program-only" << eom;
+      exit(1); // should contemplate EX_USAGE from sysexits.h
+    }
+    options.set_option("incremental-unwind", true);
+  }
+
   if(cmdline.isset("depth"))
     options.set_option("depth", cmdline.get_value("depth"));
 
@@ -205,6 +244,11 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  // rewrite the equation at word level
+  options.set_option(
+    "rewrite-formula",
+    cmdline.isset("rewrite-formula"));
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -389,6 +433,12 @@ int jbmc_parse_optionst::doit()
     return 0; // should contemplate EX_OK from sysexits.h
   }
 
+  if(cmdline.isset("show-symex-strategies"))
+  {
+    std::cout << show_path_strategies();
+    return 0; // should contemplate EX_OK from sysexits.h
+  }
+
   //
   // command line options
   //
@@ -76,6 +76,13 @@ public:
   */
   static bool has_dereference(const exprt &expr);
 
+  /*! \brief Restarts the numbering of invalid objects
+  */
+  static void reset_invalid_counter()
+  {
+    invalid_counter=0;
+  }
+
   typedef std::unordered_set<exprt, irep_hash> expr_sett;
 
 private:
@@ -8,6 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "arrays.h"
 
+#include <vector>
+
 #include <langapi/language_util.h>
 
 #include <util/std_expr.h>
@@ -293,14 +295,76 @@ void arrayst::add_array_constraints()
   add_array_Ackermann_constraints();
 }
 
+/// Splits \p index into a base and a constant offset, such that \p index
+/// is base+offset. A constant index has a nil base. The offset is taken
+/// modulo the range of the type of \p index, as is the addition.
+static void split_index(
+  const exprt &index,
+  exprt &base,
+  mp_integer &offset)
+{
+  const typet &type=index.type();
+
+  base=index;
+  offset=0;
+
+  if(type.id()!=ID_signedbv && type.id()!=ID_unsignedbv)
+    return;
+
+  mp_integer c;
+
+  if(index.is_constant())
+  {
+    if(to_integer(index, offset))
+      return;
+
+    base.make_nil();
+  }
+  else if((index.id()==ID_plus || index.id()==ID_minus) &&
+          index.operands().size()==2 &&
+          index.op1().is_constant() &&
+          index.op1().type()==type &&
+          !to_integer(index.op1(), c))
+  {
+    base=index.op0();
+    offset=index.id()==ID_plus?c:-c;
+  }
+  else if(index.id()==ID_plus &&
+          index.operands().size()==2 &&
+          index.op0().is_constant() &&
+          index.op0().type()==type &&
+          !to_integer(index.op0(), c))
+  {
+    base=index.op1();
+    offset=c;
+  }
+  else
+    return;
+
+  const mp_integer range=power(2, to_bitvector_type(type).get_width());
+  offset%=range;
+  if(offset<0)
+    offset+=range;
+}
+
 void arrayst::add_array_Ackermann_constraints()
 {
-  // this is quadratic!
+  // This is quadratic in the number of indices of an array that may be
+  // equal. Indices that only differ in a constant offset from the same
+  // base, e.g., i+1 and i+2, are never equal, and constants aren't
+  // compared either. Hence, the indices are put into classes by their
+  // type and base, and only pairs from different classes, or with the
+  // same offset, are constrained.
 
 #ifdef DEBUG
   std::cout << "arrays.size(): " << arrays.size() << '\n';
 #endif
 
+  std::size_t constraints=0, pairs_skipped=0;
+
+  typedef std::map<mp_integer, std::vector<exprt>> offsetst;
+  typedef std::map<std::pair<typet, exprt>, offsetst> index_classest;
+
   // iterate over arrays
   for(std::size_t i=0; i<arrays.size(); i++)
   {
@@ -310,53 +374,106 @@ void arrayst::add_array_Ackermann_constraints()
     std::cout << "index_set.size(): " << index_set.size() << '\n';
 #endif
 
-    // iterate over indices, 2x!
-    for(index_sett::const_iterator
-        i1=index_set.begin();
-        i1!=index_set.end();
-        i1++)
-      for(index_sett::const_iterator
-          i2=i1;
-          i2!=index_set.end();
-          i2++)
-        if(i1!=i2)
-        {
-          if(i1->is_constant() && i2->is_constant())
-            continue;
+    if(index_set.size()<2)
+      continue;
 
-          // index equality
-          equal_exprt indices_equal(*i1, *i2);
+    index_classest index_classes;
 
-          if(indices_equal.op0().type()!=
-             indices_equal.op1().type())
-          {
-            indices_equal.op1().
-              make_typecast(indices_equal.op0().type());
-          }
+    for(const auto &index : index_set)
+    {
+      exprt base;
+      mp_integer offset;
+      split_index(index, base, offset);
+      index_classes[std::make_pair(index.type(), base)][offset].push_back(
+        index);
+    }
+
+    for(index_classest::const_iterator
+        c1=index_classes.begin();
+        c1!=index_classes.end();
+        c1++)
+    {
+      std::size_t class_size=0;
 
-          literalt indices_equal_lit=convert(indices_equal);
+      // same class: only the indices with the same offset may be equal
+      for(const auto &indices : c1->second)
+      {
+        for(std::size_t k1=0; k1<indices.second.size(); k1++)
+          for(std::size_t k2=k1+1; k2<indices.second.size(); k2++)
+            constraints+=
+              add_array_Ackermann_constraint(
+                i, indices.second[k1], indices.second[k2]);
+
+        pairs_skipped+=class_size*indices.second.size();
+        class_size+=indices.second.size();
+      }
 
-          if(indices_equal_lit!=const_literal(false))
-          {
-            const typet &subtype=ns.follow(arrays[i].type()).subtype();
-            index_exprt index_expr1(arrays[i], *i1, subtype);
+      const bool c1_constant=c1->first.second.is_nil();
 
-            index_exprt index_expr2=index_expr1;
-            index_expr2.index()=*i2;
+      // different classes: any two indices may be equal
+      for(index_classest::const_iterator c2=std::next(c1);
+          c2!=index_classes.end();
+          c2++)
+      {
+        if(c1_constant && c2->first.second.is_nil())
+          continue;
+
+        for(const auto &indices1 : c1->second)
+          for(const auto &i1 : indices1.second)
+            for(const auto &indices2 : c2->second)
+              for(const auto &i2 : indices2.second)
+                constraints+=add_array_Ackermann_constraint(i, i1, i2);
+      }
+    }
+  }
 
-            equal_exprt values_equal(index_expr1, index_expr2);
+  if(constraints!=0 || pairs_skipped!=0)
+    statistics() << "Array Ackermann constraints: " << constraints
+                 << " (" << pairs_skipped << " index pairs cannot be equal)"
+                 << eom;
+}
 
-            // add constraint
-            lazy_constraintt lazy(lazy_typet::ARRAY_ACKERMANN,
-              implies_exprt(literal_exprt(indices_equal_lit), values_equal));
-            add_array_constraint(lazy, true); // added lazily
+/// Adds the constraint that the elements of array number \p i at
+/// \p index1 and \p index2 are equal if the indices are
+/// \return true if a constraint was added
+bool arrayst::add_array_Ackermann_constraint(
+  std::size_t i,
+  const exprt &index1,
+  const exprt &index2)
+{
+  // index equality
+  equal_exprt indices_equal(index1, index2);
+
+  if(indices_equal.op0().type()!=
+     indices_equal.op1().type())
+  {
+    indices_equal.op1().
+      make_typecast(indices_equal.op0().type());
+  }
+
+  literalt indices_equal_lit=convert(indices_equal);
+
+  if(indices_equal_lit==const_literal(false))
+    return false;
+
+  const typet &subtype=ns.follow(arrays[i].type()).subtype();
+  index_exprt index_expr1(arrays[i], index1, subtype);
+
+  index_exprt index_expr2=index_expr1;
+  index_expr2.index()=index2;
+
+  equal_exprt values_equal(index_expr1, index_expr2);
+
+  // add constraint
+  lazy_constraintt lazy(lazy_typet::ARRAY_ACKERMANN,
+    implies_exprt(literal_exprt(indices_equal_lit), values_equal));
+  add_array_constraint(lazy, true); // added lazily
 
 #if 0 // old code for adding, not significantly faster
-            prop.lcnf(!indices_equal_lit, convert(values_equal));
+  prop.lcnf(!indices_equal_lit, convert(values_equal));
 #endif
-          }
-        }
-  }
+
+  return true;
 }
 
 /// merge the indices into the root
@@ -101,6 +101,8 @@ protected:
   // adds all the constraints eagerly
   void add_array_constraints();
   void add_array_Ackermann_constraints();
+  bool add_array_Ackermann_constraint(
+    std::size_t i, const exprt &index1, const exprt &index2);
   void add_array_constraints_equality(
     const index_sett &index_set, const array_equalityt &array_equality);
   void add_array_constraints(
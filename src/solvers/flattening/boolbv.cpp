@@ -710,6 +710,28 @@ void boolbvt::print_assignment(std::ostream &out) const
   }
 }
 
+void boolbvt::output_circuit_statistics()
+{
+  const bv_utilst::circuit_statisticst &circuits=
+    bv_utils.get_circuit_statistics();
+
+  const std::size_t multipliers=
+    circuits.shift_add_multipliers+
+    circuits.wallace_tree_multipliers+
+    circuits.csd_multipliers;
+
+  if(multipliers!=0)
+    statistics() << "Multipliers: "
+                 << circuits.shift_add_multipliers << " shift-add, "
+                 << circuits.wallace_tree_multipliers << " Wallace tree, "
+                 << circuits.csd_multipliers << " constant (CSD)" << eom;
+
+  if(circuits.dividers!=0 || circuits.shift_dividers!=0)
+    statistics() << "Dividers: "
+                 << circuits.dividers << " general, "
+                 << circuits.shift_dividers << " by a power of two" << eom;
+}
+
 void boolbvt::build_offset_map(const struct_typet &src, offset_mapt &dest)
 {
   const struct_typet::componentst &components=
@@ -62,6 +62,7 @@ public:
     post_process_quantifiers();
     functions.post_process();
     SUB::post_process();
+    output_circuit_statistics();
   }
 
   // get literals for variables/expressions, if available
@@ -75,6 +76,14 @@ public:
   enum class unbounded_arrayt { U_NONE, U_ALL, U_AUTO };
   unbounded_arrayt unbounded_array;
 
+  void set_arithmetic_encoding(
+    bv_utilst::multiplier_encodingt multiplier_encoding,
+    bool specialize_constant_operands)
+  {
+    bv_utils.multiplier_encoding=multiplier_encoding;
+    bv_utils.specialize_constant_operands=specialize_constant_operands;
+  }
+
   mp_integer get_value(const bvt &bv)
   {
     return get_value(bv, 0, bv.size());
@@ -105,6 +114,8 @@ protected:
   // NOLINTNEXTLINE(readability/identifiers)
   typedef arrayst SUB;
 
+  void output_circuit_statistics();
+
   void conversion_failed(const exprt &expr, bvt &bv)
   {
     bv=conversion_failed(expr);
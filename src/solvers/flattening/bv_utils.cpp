@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cassert>
 
 #include <util/arith_tools.h>
+#include <util/invariant.h>
 
 bvt bv_utilst::build_constant(const mp_integer &n, std::size_t width)
 {
@@ -613,12 +614,34 @@ bvt bv_utilst::wallace_tree(const std::vector<bvt> &pps)
 
 bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
 {
-  #if 1
   bvt op0=_op0, op1=_op1;
 
   if(is_constant(op1))
     std::swap(op0, op1);
 
+  if(specialize_constant_operands && is_constant(op0))
+  {
+    circuit_statistics.csd_multipliers++;
+    return constant_multiplier(op0, op1);
+  }
+
+  switch(multiplier_encoding)
+  {
+  case multiplier_encodingt::SHIFT_ADD:
+    circuit_statistics.shift_add_multipliers++;
+    return shift_add_multiplier(op0, op1);
+
+  case multiplier_encodingt::WALLACE_TREE:
+    circuit_statistics.wallace_tree_multipliers++;
+    return wallace_tree_multiplier(op0, op1);
+  }
+
+  UNREACHABLE;
+}
+
+/// Adds up the partial products of \p op0 and \p op1 one after another
+bvt bv_utilst::shift_add_multiplier(const bvt &op0, const bvt &op1)
+{
   bvt product;
   product.resize(op0.size());
 
@@ -642,17 +665,14 @@ bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
     }
 
   return product;
-  #else
-  // Wallace tree multiplier. This is disabled, as runtimes have
-  // been observed to go up by 5%-10%, and on some models even by 20%.
+}
 
+/// Adds up the partial products of \p op0 and \p op1 using a Wallace tree.
+/// This is not the default, as runtimes have been observed to go up by
+/// 5%-10%, and on some models even by 20%.
+bvt bv_utilst::wallace_tree_multiplier(const bvt &op0, const bvt &op1)
+{
   // build the usual quadratic number of partial products
-
-  bvt op0=_op0, op1=_op1;
-
-  if(is_constant(op1))
-    std::swap(op0, op1);
-
   std::vector<bvt> pps;
   pps.reserve(op0.size());
 
@@ -677,8 +697,42 @@ bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
     return zeros(op0.size());
   else
     return wallace_tree(pps);
+}
 
-  #endif
+/// Multiplies \p op1 by the constant \p op0 using the canonical signed
+/// digit form of \p op0, in which no two adjacent digits are non-zero. A
+/// run of ones, e.g., 0111, becomes 100(-1), so that there are at most
+/// about half as many additions or subtractions as there are bits.
+bvt bv_utilst::constant_multiplier(const bvt &op0, const bvt &op1)
+{
+  PRECONDITION(is_constant(op0));
+
+  const std::size_t width=op0.size();
+  bvt product=zeros(width);
+  bool carry=false;
+
+  for(std::size_t i=0; i<width; i++)
+  {
+    const bool bit=op0[i].is_true();
+    const bool next=i+1<width && op0[i+1].is_true();
+
+    // the digit at i, from bit i, the carry, and the next bit
+    int digit=0;
+
+    if(bit!=carry)
+    {
+      digit=next?-1:1;
+      carry=next;
+    }
+
+    if(digit!=0)
+    {
+      const bvt term=shift(op1, shiftt::LEFT, i);
+      product=add_sub(product, term, digit<0);
+    }
+  }
+
+  return product;
 }
 
 bvt bv_utilst::unsigned_multiplier_no_overflow(
@@ -879,7 +933,7 @@ void bv_utilst::unsigned_divider(
   std::size_t width=op0.size();
 
   // check if we divide by a power of two
-  #if 0
+  if(specialize_constant_operands)
   {
     std::size_t one_count=0, non_const_count=0, one_pos=0;
 
@@ -895,10 +949,11 @@ void bv_utilst::unsigned_divider(
         non_const_count++;
     }
 
-    if(non_const_count==0 && one_count==1 && one_pos!=0)
+    if(non_const_count==0 && one_count==1)
     {
       // it is a power of two!
-      res=shift(op0, LRIGHT, one_pos);
+      circuit_statistics.shift_dividers++;
+      res=shift(op0, shiftt::LRIGHT, one_pos);
 
       // remainder is just a mask
       rem=op0;
@@ -907,7 +962,8 @@ void bv_utilst::unsigned_divider(
       return;
     }
   }
-  #endif
+
+  circuit_statistics.dividers++;
 
   // Division by zero test.
   // Note that we produce a non-deterministic result in
@@ -26,7 +26,35 @@ Author: Daniel Kroening, kroening@kroening.com
 class bv_utilst
 {
 public:
-  explicit bv_utilst(propt &_prop):prop(_prop) { }
+  explicit bv_utilst(propt &_prop):
+    multiplier_encoding(multiplier_encodingt::SHIFT_ADD),
+    specialize_constant_operands(false),
+    prop(_prop)
+  {
+  }
+
+  /// How unsigned_multiplier sums up the partial products
+  enum class multiplier_encodingt { SHIFT_ADD, WALLACE_TREE };
+  multiplier_encodingt multiplier_encoding;
+
+  /// Multiply by constants using their canonical signed digit form, and
+  /// divide by constant powers of two by shifting
+  bool specialize_constant_operands;
+
+  /// The number of multipliers and dividers built, by encoding
+  struct circuit_statisticst
+  {
+    std::size_t shift_add_multipliers=0;
+    std::size_t wallace_tree_multipliers=0;
+    std::size_t csd_multipliers=0;
+    std::size_t dividers=0;
+    std::size_t shift_dividers=0;
+  };
+
+  const circuit_statisticst &get_circuit_statistics() const
+  {
+    return circuit_statistics;
+  }
 
   enum class representationt { SIGNED, UNSIGNED };
 
@@ -239,6 +267,12 @@ protected:
   bvt cond_negate_no_overflow(const bvt &bv, const literalt cond);
 
   bvt wallace_tree(const std::vector<bvt> &pps);
+
+  bvt shift_add_multiplier(const bvt &op0, const bvt &op1);
+  bvt wallace_tree_multiplier(const bvt &op0, const bvt &op1);
+  bvt constant_multiplier(const bvt &op0, const bvt &op1);
+
+  circuit_statisticst circuit_statistics;
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_BV_UTILS_H
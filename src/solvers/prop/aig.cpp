@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cassert>
 #include <ostream>
 #include <string>
+#include <utility>
 
 std::string aigt::label(nodest::size_type v) const
 {
@@ -22,6 +23,21 @@ std::string aigt::dot_label(nodest::size_type v) const
   return "var("+std::to_string(v)+")";
 }
 
+literalt aigt::hashed_and_node(literalt a, literalt b)
+{
+  if(b<a)
+    std::swap(a, b);
+
+  const std::uint64_t key=(std::uint64_t(a.get())<<32) | b.get();
+
+  const auto entry=and_nodes.insert({key, 0});
+
+  if(entry.second)
+    entry.first->second=new_and_node(a, b).var_no();
+
+  return literalt(entry.first->second, false);
+}
+
 void aigt::get_terminals(terminalst &terminals) const
 {
   for(nodest::size_type n=0; n<nodes.size(); n++)
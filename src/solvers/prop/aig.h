@@ -12,9 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_PROP_AIG_H
 #define CPROVER_SOLVERS_PROP_AIG_H
 
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 
 #include <solvers/prop/literal.h>
 
@@ -67,6 +69,7 @@ public:
   void clear()
   {
     nodes.clear();
+    and_nodes.clear();
   }
 
   typedef std::set<literalt::var_not> terminal_sett;
@@ -94,6 +97,7 @@ public:
   void swap(aigt &g)
   {
     nodes.swap(g.nodes);
+    and_nodes.swap(g.and_nodes);
   }
 
   literalt new_node()
@@ -118,6 +122,10 @@ public:
     return l;
   }
 
+  /// Returns an AND node with inputs \p a and \p b, re-using an existing
+  /// node with the same inputs (in either order) if there is one
+  literalt hashed_and_node(literalt a, literalt b);
+
   bool empty() const
   {
     return nodes.empty();
@@ -134,6 +142,9 @@ public:
   std::string dot_label(nodest::size_type v) const;
 
 protected:
+  // the AND nodes created by hashed_and_node, by their inputs
+  std::unordered_map<std::uint64_t, literalt::var_not> and_nodes;
+
   const std::set<literalt::var_not> &get_terminals_rec(
     literalt::var_not n,
     terminalst &terminals) const;
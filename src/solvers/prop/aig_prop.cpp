@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "aig_prop.h"
 
+#include <algorithm>
 #include <set>
 #include <stack>
 
@@ -15,42 +16,90 @@ Author: Daniel Kroening, kroening@kroening.com
 // Needed to match the performance of the native CNF back-end.
 #define USE_AIG_COMPACT
 
-// Use the Plaisted-Greenbaum encoding, again, needed to match the
-// native CNF back-end.
-#define USE_PG
+// The Plaisted-Greenbaum encoding is always used, again, needed to match
+// the native CNF back-end. It also tells which nodes the constraints
+// added since the previous call to prop_solve need.
 
 literalt aig_prop_baset::land(const bvt &bv)
 {
-  literalt literal=const_literal(true);
+  bvt operands;
+  operands.reserve(bv.size());
+
+  forall_literals(it, bv)
+  {
+    if(it->is_false())
+      return *it;
+    if(!it->is_true())
+      operands.push_back(*it);
+  }
+
+  // Sorting makes equal conjunctions produce equal trees, which are then
+  // shared by structural hashing. A literal and its negation end up next
+  // to each other.
+  std::sort(operands.begin(), operands.end());
+  operands.erase(
+    std::unique(operands.begin(), operands.end()), operands.end());
+
+  for(std::size_t i=1; i<operands.size(); i++)
+    if(operands[i]==neg(operands[i-1]))
+      return const_literal(false);
+
+  if(operands.empty())
+    return const_literal(true);
 
   // Introduces N-1 extra nodes for N bits
   // See convert_node for where this overhead is removed
-  forall_literals(it, bv)
-    literal=land(*it, literal);
+  while(operands.size()>1)
+  {
+    bvt next;
+    next.reserve((operands.size()+1)/2);
+
+    for(std::size_t i=0; i+1<operands.size(); i+=2)
+      next.push_back(land(operands[i], operands[i+1]));
+
+    if(operands.size()%2==1)
+      next.push_back(operands.back());
 
-  return literal;
+    operands.swap(next);
+  }
+
+  return operands.front();
 }
 
 literalt aig_prop_baset::lor(const bvt &bv)
 {
-  literalt literal=const_literal(true);
+  bvt negated;
+  negated.reserve(bv.size());
 
-  // Introduces N-1 extra nodes for N bits
-  // See convert_node for where this overhead is removed
   forall_literals(it, bv)
-    literal=land(neg(*it), literal);
+    negated.push_back(neg(*it));
 
-  return neg(literal);
+  return neg(land(negated)); // De Morgan's
 }
 
 literalt aig_prop_baset::lxor(const bvt &bv)
 {
-  literalt literal=const_literal(false);
+  if(bv.empty())
+    return const_literal(false);
 
-  forall_literals(it, bv)
-    literal=lxor(*it, literal);
+  // a balanced tree, as for land
+  bvt operands=bv;
+
+  while(operands.size()>1)
+  {
+    bvt next;
+    next.reserve((operands.size()+1)/2);
+
+    for(std::size_t i=0; i+1<operands.size(); i+=2)
+      next.push_back(lxor(operands[i], operands[i+1]));
+
+    if(operands.size()%2==1)
+      next.push_back(operands.back());
 
-  return literal;
+    operands.swap(next);
+  }
+
+  return operands.front();
 }
 
 literalt aig_prop_baset::land(literalt a, literalt b)
@@ -65,7 +114,86 @@ literalt aig_prop_baset::land(literalt a, literalt b)
   if(a==b)
     return a;
 
-  return dest.new_and_node(a, b);
+  literalt result;
+  if(rewrite_and(a, b, result) || rewrite_and(b, a, result))
+    return result;
+
+  return dest.hashed_and_node(a, b);
+}
+
+/// Applies the two-level rewrite rules for `a AND b` that look into \p a,
+/// which must not be constant. None of them introduces more than one node.
+/// \return true if `a AND b` was rewritten into \p result
+bool aig_prop_baset::rewrite_and(literalt a, literalt b, literalt &result)
+{
+  // a copy, as land below may add nodes
+  const aigt::nodet node=dest.get_node(a);
+
+  if(!node.is_and())
+    return false;
+
+  const literalt x=node.a;
+  const literalt y=node.b;
+
+  const aigt::nodet other=dest.get_node(b);
+
+  if(!a.sign())
+  {
+    // contradiction: (x AND y) AND !x = false
+    if(b==neg(x) || b==neg(y))
+    {
+      result=const_literal(false);
+      return true;
+    }
+
+    // idempotence: (x AND y) AND x = x AND y
+    if(b==x || b==y)
+    {
+      result=a;
+      return true;
+    }
+
+    // contradiction: (x AND y) AND (!x AND z) = false
+    if(!b.sign() && other.is_and() &&
+       (other.a==neg(x) || other.a==neg(y) ||
+        other.b==neg(x) || other.b==neg(y)))
+    {
+      result=const_literal(false);
+      return true;
+    }
+  }
+  else
+  {
+    // subsumption: !(x AND y) AND !x = !x
+    if(b==neg(x) || b==neg(y))
+    {
+      result=b;
+      return true;
+    }
+
+    // substitution: !(x AND y) AND x = !y AND x
+    if(b==x || b==y)
+    {
+      result=land(neg(b==x?y:x), b);
+      return true;
+    }
+
+    // resolution: !(x AND y) AND !(x AND !y) = !x
+    if(b.sign() && other.is_and())
+    {
+      for(const auto &p : { std::make_pair(x, y), std::make_pair(y, x) })
+      {
+        if((other.a==p.first && other.b==neg(p.second)) ||
+           (other.b==p.first && other.a==neg(p.second)))
+        {
+          result=neg(p.first);
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
 }
 
 literalt aig_prop_baset::lor(literalt a, literalt b)
@@ -146,7 +274,68 @@ void aig_prop_baset::set_equal(literalt a, literalt b)
 
 tvt aig_prop_solvert::l_get(literalt a) const
 {
-  return solver.l_get(a);
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  // The Plaisted-Greenbaum encoding leaves the variables of AND nodes
+  // unconstrained in one phase, and nodes may have been inlined. Hence,
+  // AND nodes are evaluated from the values of the variables.
+  values.resize(aig.nodes.size());
+  evaluated.resize(aig.nodes.size(), false);
+
+  std::stack<literalt::var_not> stack;
+  stack.push(a.var_no());
+
+  while(!stack.empty())
+  {
+    const literalt::var_not n=stack.top();
+
+    if(evaluated[n])
+    {
+      stack.pop();
+      continue;
+    }
+
+    const aigt::nodet &node=aig.nodes[n];
+
+    if(node.is_var())
+    {
+      if(n<solver.no_variables())
+        values[n]=solver.l_get(literalt(n, false));
+      else
+        values[n]=tvt::unknown(); // added after the last solve
+    }
+    else
+    {
+      bool ready=true;
+
+      for(const literalt l : { node.a, node.b })
+      {
+        if(!l.is_constant() && !evaluated[l.var_no()])
+        {
+          stack.push(l.var_no());
+          ready=false;
+        }
+      }
+
+      if(!ready)
+        continue;
+
+      const auto value=[this](literalt l)
+      {
+        if(l.is_constant())
+          return tvt(l.is_true());
+        return l.sign()?!values[l.var_no()]:values[l.var_no()];
+      };
+
+      values[n]=value(node.a) && value(node.b);
+    }
+
+    evaluated[n]=true;
+    stack.pop();
+  }
+
+  return a.sign()?!values[a.var_no()]:values[a.var_no()];
 }
 
 propt::resultt aig_prop_solvert::prop_solve()
@@ -155,10 +344,17 @@ propt::resultt aig_prop_solvert::prop_solve()
            << aig.nodes.size() << " nodes" << eom;
   convert_aig();
 
+  solver.set_assumptions(assumptions);
+
+  values.clear();
+  evaluated.clear();
+
   return solver.prop_solve();
 }
 
-/// Compute the phase information needed for Plaisted-Greenbaum encoding
+/// Compute the phase information needed for Plaisted-Greenbaum encoding,
+/// starting from the new constraints and the assumptions, and leaving out
+/// phases that have been converted by an earlier call
 /// \par parameters: Two vectors of bools of size aig.nodes.size()
 /// \return These vectors filled in with per node phase information
 void aig_prop_solvert::compute_phase(
@@ -168,11 +364,11 @@ void aig_prop_solvert::compute_phase(
   std::stack<literalt> queue;
 
   // Get phases of constraints
-  for(aig_plus_constraintst::constraintst::const_iterator
-      c_it=aig.constraints.begin();
-      c_it!=aig.constraints.end();
-      c_it++)
-    queue.push(*c_it);
+  for(std::size_t c=converted_constraints; c<aig.constraints.size(); c++)
+    queue.push(aig.constraints[c]);
+
+  forall_literals(it, assumptions)
+    queue.push(*it);
 
   while(!queue.empty())
   {
@@ -186,7 +382,9 @@ void aig_prop_solvert::compute_phase(
     unsigned var_no=l.var_no();
 
     // already set?
-    if(sign?n_neg[var_no]:n_pos[var_no])
+    if(sign?
+       (n_neg[var_no] || converted_neg[var_no]):
+       (n_pos[var_no] || converted_pos[var_no]))
       continue; // done already
 
     // set
@@ -223,27 +421,32 @@ void aig_prop_solvert::compute_phase(
 }
 
 
-/// Compact encoding for single usage variable
-/// \par parameters: Two vectors of unsigned of size aig.nodes.size()
+/// Compact encoding for single usage variable, counting the uses by the
+/// new constraints, the assumptions and the nodes to be converted
+/// \par parameters: The phases to be converted, and two vectors of unsigned
+///   of size aig.nodes.size()
 /// \return These vectors filled in with per node usage information
 void aig_prop_solvert::usage_count(
+  const std::vector<bool> &n_pos,
+  const std::vector<bool> &n_neg,
   std::vector<unsigned> &p_usage_count,
   std::vector<unsigned> &n_usage_count)
 {
-  for(aig_plus_constraintst::constraintst::const_iterator
-      c_it=aig.constraints.begin();
-      c_it!=aig.constraints.end();
-      c_it++)
+  bvt roots(
+    aig.constraints.begin()+converted_constraints, aig.constraints.end());
+  roots.insert(roots.end(), assumptions.begin(), assumptions.end());
+
+  forall_literals(it, roots)
   {
-    if(!((*c_it).is_constant()))
+    if(!it->is_constant())
     {
-      if((*c_it).sign())
+      if(it->sign())
       {
-        ++n_usage_count[(*c_it).var_no()];
+        ++n_usage_count[it->var_no()];
       }
       else
       {
-        ++p_usage_count[(*c_it).var_no()];
+        ++p_usage_count[it->var_no()];
       }
     }
   }
@@ -252,7 +455,12 @@ void aig_prop_solvert::usage_count(
   {
     const aigt::nodet &node=aig.nodes[n];
 
-    if(node.is_and())
+    // The clauses of earlier calls count as a use. This keeps nodes from
+    // being inlined whose inputs compute_phase did not visit.
+    if(converted_pos[n] || converted_neg[n])
+      ++p_usage_count[n];
+
+    if(node.is_and() && (n_pos[n] || n_neg[n]))
     {
       if(node.a.sign())
       {
@@ -554,45 +762,51 @@ void aig_prop_solvert::convert_aig()
   while(solver.no_variables()<=aig.nodes.size())
     solver.new_variable();
 
-  // Usage count for inlining
+  converted_pos.resize(aig.nodes.size(), false);
+  converted_neg.resize(aig.nodes.size(), false);
 
-  std::vector<unsigned> p_usage_count;
-  std::vector<unsigned> n_usage_count;
-  p_usage_count.resize(aig.nodes.size(), 0);
-  n_usage_count.resize(aig.nodes.size(), 0);
-
-  this->usage_count(p_usage_count, n_usage_count);
-
-
-  #ifdef USE_PG
   // Get phases
   std::vector<bool> n_pos, n_neg;
   n_pos.resize(aig.nodes.size(), false);
   n_neg.resize(aig.nodes.size(), false);
 
   this->compute_phase(n_pos, n_neg);
-  #endif
+
+  // Usage count for inlining
+
+  std::vector<unsigned> p_usage_count;
+  std::vector<unsigned> n_usage_count;
+  p_usage_count.resize(aig.nodes.size(), 0);
+  n_usage_count.resize(aig.nodes.size(), 0);
+
+  this->usage_count(n_pos, n_neg, p_usage_count, n_usage_count);
 
   // 2. Do nodes
   for(std::size_t n=aig.nodes.size() - 1; n!=0; n--)
   {
-    if(aig.nodes[n].is_and())
+    if(aig.nodes[n].is_and() && (n_pos[n] || n_neg[n]))
     {
-#ifdef USE_PG
+      // nodes that are inlined into all their uses are not converted,
+      // and may still be needed by later calls
+      const bool used=p_usage_count[n]>0 || n_usage_count[n]>0;
+
       convert_node(
         n, aig.nodes[n], n_pos[n], n_neg[n], p_usage_count, n_usage_count);
-#else
-      convert_node(n, aig.nodes[n], true, true, p_usage_count, n_usage_count);
-#endif
+
+      if(used)
+      {
+        if(n_pos[n])
+          converted_pos[n]=true;
+        if(n_neg[n])
+          converted_neg[n]=true;
+      }
     }
   }
   // Skip zero as it is not used or a valid literal
 
-
   // 3. Do constraints
-  for(const auto &c_it : aig.constraints)
-    solver.l_set_to(c_it, true);
+  for(std::size_t c=converted_constraints; c<aig.constraints.size(); c++)
+    solver.l_set_to(aig.constraints[c], true);
 
-  // HACK!
-  aig.nodes.clear();
+  converted_constraints=aig.constraints.size();
 }
@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_PROP_AIG_PROP_H
 
 #include <cassert>
+#include <cstdint>
+#include <vector>
 
 #include <util/threeval.h>
 #include <solvers/prop/prop.h>
@@ -62,6 +64,8 @@ public:
 
 protected:
   aigt &dest;
+
+  bool rewrite_and(literalt a, literalt b, literalt &result);
 };
 
 class aig_prop_constraintt:public aig_prop_baset
@@ -92,8 +96,11 @@ class aig_prop_solvert:public aig_prop_constraintt
 public:
   explicit aig_prop_solvert(propt &_solver):
     aig_prop_constraintt(aig),
-    solver(_solver)
+    solver(_solver),
+    converted_constraints(0)
   {
+    // node 0 is never converted, see convert_aig
+    aig.new_var_node();
   }
 
   aig_plus_constraintst aig;
@@ -108,6 +115,36 @@ public:
   tvt l_get(literalt a) const override;
   resultt prop_solve() override;
 
+  void set_assumptions(const bvt &_assumptions) override
+  {
+    assumptions=_assumptions;
+  }
+
+  bool has_set_assumptions() const override
+  {
+    return solver.has_set_assumptions();
+  }
+
+  bool is_in_conflict(literalt l) const override
+  {
+    return solver.is_in_conflict(l);
+  }
+
+  bool has_is_in_conflict() const override
+  {
+    return solver.has_is_in_conflict();
+  }
+
+  void set_frozen(literalt a) override
+  {
+    solver.set_frozen(a);
+  }
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    solver.set_time_limit_seconds(lim);
+  }
+
   void set_message_handler(message_handlert &m) override
   {
     aig_prop_constraintt::set_message_handler(m);
@@ -116,10 +153,24 @@ public:
 
 protected:
   propt &solver;
+  bvt assumptions;
+
+  // The graph is converted incrementally: every call to prop_solve
+  // converts the constraints added since the previous call, and the nodes
+  // that these and the assumptions need in a phase not converted before.
+  std::size_t converted_constraints;
+  std::vector<bool> converted_pos, converted_neg;
+
+  // the values of the nodes in the last solution, evaluated on demand
+  mutable std::vector<tvt> values;
+  mutable std::vector<bool> evaluated;
 
   void convert_aig();
   void usage_count(
-    std::vector<unsigned> &p_usage_count, std::vector<unsigned> &n_usage_count);
+    const std::vector<bool> &n_pos,
+    const std::vector<bool> &n_neg,
+    std::vector<unsigned> &p_usage_count,
+    std::vector<unsigned> &n_usage_count);
   void compute_phase(std::vector<bool> &n_pos, std::vector<bool> &n_neg);
   void convert_node(
     unsigned n,
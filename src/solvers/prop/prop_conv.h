@@ -51,6 +51,9 @@ public:
   virtual void set_assumptions(const bvt &_assumptions);
   virtual bool has_set_assumptions() const { return false; }
   virtual void set_all_frozen() {}
+  // run post-processing (again) in the next call to dec_solve, to account
+  // for constraints that were added since the last call
+  virtual void reset_post_processing() {}
 
   // returns true if an assumption is in the final conflict
   virtual bool is_in_conflict(literalt l) const;
@@ -97,6 +100,8 @@ public:
   virtual bool has_set_assumptions() const override
   { return prop.has_set_assumptions(); }
   virtual void set_all_frozen() override { freeze_all = true; }
+  virtual void reset_post_processing() override
+  { post_processing_done = false; }
   virtual literalt convert(const exprt &expr) override;
   virtual bool is_in_conflict(literalt l) const override
   { return prop.is_in_conflict(l); }
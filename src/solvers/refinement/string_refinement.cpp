@@ -22,8 +22,11 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 #include <iomanip>
 #include <numeric>
 #include <stack>
+#include <sstream>
 #include <util/expr_iterator.h>
 #include <util/arith_tools.h>
+#include <util/forked_tasks.h>
+#include <util/irep_serialization.h>
 #include <util/simplify_expr.h>
 #include <solvers/sat/satcheck.h>
 #include <solvers/refinement/string_constraint_instantiation.h>
@@ -41,6 +44,12 @@ static optionalt<exprt> find_counter_example(
   const exprt &axiom,
   const symbol_exprt &var);
 
+static std::vector<optionalt<exprt>> find_counter_examples(
+  const namespacet &ns,
+  ui_message_handlert::uit ui,
+  const std::vector<std::pair<exprt, symbol_exprt>> &queries,
+  unsigned jobs);
+
 /// Check axioms takes the model given by the underlying solver and answers
 /// whether it satisfies the string constraints.
 ///
@@ -66,7 +75,8 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
   std::size_t max_string_length,
   bool use_counter_example,
   ui_message_handlert::uit ui,
-  const union_find_replacet &symbol_resolve);
+  const union_find_replacet &symbol_resolve,
+  unsigned jobs);
 
 static void initial_index_set(
   index_set_pairt &index_set,
@@ -95,20 +105,23 @@ static void update_index_set(
   const namespacet &ns,
   const exprt &formula);
 
+static void index_universal_axioms(string_axiomst &axioms);
+
 /// Substitute `qvar` the universally quantified variable of `axiom`, by
-/// an index `val`, in `axiom`, so that the index used for `str` equals `val`.
-/// For instance, if `axiom` corresponds to \f$\forall q.\ s[q+x]='a' \land
-/// t[q]='b'\f$, `instantiate(axiom,s,v)` would return an expression for
+/// an index `val`, in `axiom`, so that index `idx` of some string equals
+/// `val`. For instance, if `axiom` corresponds to
+/// \f$\forall q.\ s[q+x]='a' \land t[q]='b'\f$,
+/// `instantiate(axiom,q+x,v)` would return an expression for
 /// \f$s[v]='a' \land t[v-x]='b'\f$.
 /// \param stream: output stream
 /// \param axiom: a universally quantified formula
-/// \param str: an array of char variable
+/// \param idx: an index expression in `axiom` that contains `qvar`
 /// \param val: an index expression
 /// \return `axiom` with substitued `qvar`
 static exprt instantiate(
   messaget::mstreamt &stream,
   const string_constraintt &axiom,
-  const exprt &str,
+  const exprt &idx,
   const exprt &val);
 
 static std::vector<exprt> instantiate(
@@ -238,10 +251,18 @@ static std::vector<exprt> generate_instantiations(
   std::vector<exprt> lemmas;
   for(const auto &i : index_set.current)
   {
-    for(const auto &univ_axiom : axioms.universal)
+    const auto axioms_it=axioms.universal_by_string.find(i.first);
+    if(axioms_it==axioms.universal_by_string.end())
+      continue;
+
+    for(const auto &axiom_index : axioms_it->second)
     {
+      const string_constraintt &univ_axiom=
+        axioms.universal[axiom_index.first];
+
       for(const auto &j : i.second)
-        lemmas.push_back(instantiate(stream, univ_axiom, i.first, j));
+        lemmas.push_back(
+          instantiate(stream, univ_axiom, axiom_index.second, j));
     }
   }
   for(const auto &nc_axiom : axioms.not_contains)
@@ -875,7 +896,8 @@ decision_proceduret::resultt string_refinementt::dec_solve()
       generator.max_string_length,
       config_.use_counter_example,
       supert::config_.ui,
-      symbol_resolve);
+      symbol_resolve,
+      config_.jobs);
     if(!satisfied)
     {
       for(const auto &counter : counter_examples)
@@ -894,6 +916,7 @@ decision_proceduret::resultt string_refinementt::dec_solve()
     return res;
   }
 
+  index_universal_axioms(axioms);
   initial_index_set(index_sets, ns, axioms);
   update_index_set(index_sets, ns, current_constraints);
   current_constraints.clear();
@@ -923,7 +946,8 @@ decision_proceduret::resultt string_refinementt::dec_solve()
         generator.max_string_length,
         config_.use_counter_example,
         supert::config_.ui,
-        symbol_resolve);
+        symbol_resolve,
+        config_.jobs);
       if(!satisfied)
       {
         for(const auto &counter : counter_examples)
@@ -1679,7 +1703,8 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
   std::size_t max_string_length,
   bool use_counter_example,
   ui_message_handlert::uit ui,
-  const union_find_replacet &symbol_resolve)
+  const union_find_replacet &symbol_resolve,
+  unsigned jobs)
 {
   const auto eom=messaget::eom;
   static const std::string indent = "  ";
@@ -1710,8 +1735,9 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
     generator.get_index_symbols());
 #endif
 
-  // Maps from indexes of violated universal axiom to a witness of violation
-  std::map<size_t, exprt> violated;
+  // The searches for a counter-example to each axiom, the universal ones
+  // first, are independent of each other and run after all are set up.
+  std::vector<std::pair<exprt, symbol_exprt>> queries;
 
   stream << "string_refinement::check_axioms: " << axioms.universal.size()
          << " universal axioms:" << eom;
@@ -1736,20 +1762,9 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
     debug_check_axioms_step(
       stream, ns, axiom, axiom_in_model, negaxiom, with_concretized_arrays);
 
-    if(const auto &witness=
-       find_counter_example(ns, ui, with_concretized_arrays, univ_var))
-    {
-      stream << indent2 << "- violated_for: " << univ_var.get_identifier()
-             << "=" << from_expr(ns, "", *witness) << eom;
-      violated[i]=*witness;
-    }
-    else
-      stream << indent2 << "- correct" << eom;
+    queries.emplace_back(with_concretized_arrays, univ_var);
   }
 
-  // Maps from indexes of violated not_contains axiom to a witness of violation
-  std::map<std::size_t, exprt> violated_not_contains;
-
   stream << "there are " << axioms.not_contains.size()
          << " not_contains axioms" << eom;
   for(std::size_t i = 0; i < axioms.not_contains.size(); i++)
@@ -1790,12 +1805,39 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
     debug_check_axioms_step(
       stream, ns, nc_axiom, nc_axiom_in_model, negaxiom, with_concrete_arrays);
 
-    if(const auto witness = find_counter_example(ns, ui, negaxiom, univ_var))
+    queries.emplace_back(negaxiom, univ_var);
+  }
+
+  const std::vector<optionalt<exprt>> witnesses=
+    find_counter_examples(ns, ui, queries, jobs);
+
+  // Maps from indexes of violated universal axiom to a witness of violation
+  std::map<size_t, exprt> violated;
+  // Maps from indexes of violated not_contains axiom to a witness of violation
+  std::map<std::size_t, exprt> violated_not_contains;
+
+  for(std::size_t i=0; i<queries.size(); i++)
+  {
+    const bool universal=i<axioms.universal.size();
+    const std::size_t axiom_number=
+      universal?i:i-axioms.universal.size();
+
+    stream << indent << (universal?"universal ":"not_contains ")
+           << axiom_number << ".\n";
+
+    if(const auto &witness=witnesses[i])
     {
-      stream << indent2 << "- violated_for: " << univ_var.get_identifier()
+      stream << indent2 << "- violated_for: "
+             << queries[i].second.get_identifier()
              << "=" << from_expr(ns, "", *witness) << eom;
-      violated_not_contains[i]=*witness;
+
+      if(universal)
+        violated[axiom_number]=*witness;
+      else
+        violated_not_contains[axiom_number]=*witness;
     }
+    else
+      stream << indent2 << "- correct" << eom;
   }
 
   if(violated.empty() && violated_not_contains.empty())
@@ -2257,53 +2299,55 @@ static void update_index_set(
   }
 }
 
-/// Finds an index on `str` used in `expr` that contains `qvar`, for instance
-/// with arguments ``(str[k]=='a')``, `str`, and `k`, the function should
-/// return `k`.
-/// \param [in] expr: the expression to search
-/// \param [in] str: the string which must be indexed
-/// \param [in] qvar: the universal variable that must be in the index
-/// \return an index expression in `expr` on `str` containing `qvar`
-static exprt find_index(
-  const exprt &expr, const exprt &str, const symbol_exprt &qvar)
+/// Fills `axioms.universal_by_string`: for each universal axiom and each
+/// string the body of the axiom indexes with an expression that contains
+/// the quantified variable, for instance `k` in ``(str[k]=='a')``, the first
+/// such expression is recorded for the string.
+/// \param [in,out] axioms: the axioms
+static void index_universal_axioms(string_axiomst &axioms)
 {
-  const auto it=std::find_if(
-    expr.depth_begin(),
-    expr.depth_end(),
-    [&] (const exprt &e) -> bool
-    {
-      return e.id()==ID_index
-             && to_index_expr(e).array()==str
-             && find_qvar(to_index_expr(e).index(), qvar);
-    });
+  axioms.universal_by_string.clear();
+
+  for(std::size_t i=0; i<axioms.universal.size(); i++)
+  {
+    const string_constraintt &axiom=axioms.universal[i];
+    std::set<exprt> strings;
 
-  return it==expr.depth_end()
-         ?nil_exprt()
-         :to_index_expr(*it).index();
+    std::for_each(
+      axiom.body().depth_begin(),
+      axiom.body().depth_end(),
+      [&](const exprt &e) // NOLINT
+      {
+        if(e.id()==ID_index &&
+           find_qvar(to_index_expr(e).index(), axiom.univ_var()) &&
+           strings.insert(to_index_expr(e).array()).second)
+        {
+          axioms.universal_by_string[to_index_expr(e).array()].emplace_back(
+            i, to_index_expr(e).index());
+        }
+      });
+  }
 }
 
 /// Instantiates a string constraint by substituting the quantifiers.
 /// For a string constraint of the form \f$\forall q. P(x)\f$,
 /// substitute `qvar` the universally quantified variable of `axiom`, by
-/// an index `val`, in `axiom`, so that the index used for `str` equals `val`.
+/// an index `val`, in `axiom`, so that index `idx` equals `val`.
 /// For instance, if `axiom` corresponds to \f$\forall q. s[q+x]={\tt 'a'} \land
-/// t[q]={\tt 'b'} \f$, `instantiate(axiom,s,v)` would return an expression for
-/// \f$s[v]={\tt 'a'} \land t[v-x]={\tt 'b'}\f$.
+/// t[q]={\tt 'b'} \f$, `instantiate(axiom,q+x,v)` would return an expression
+/// for \f$s[v]={\tt 'a'} \land t[v-x]={\tt 'b'}\f$.
 /// \param stream: a message stream
 /// \param axiom: a universally quantified formula `axiom`
-/// \param str: an array of characters
+/// \param idx: an index expression of `axiom` that contains `qvar`, as
+///   recorded by index_universal_axioms
 /// \param val: an index expression
 /// \return instantiated formula
 static exprt instantiate(
   messaget::mstreamt &stream,
   const string_constraintt &axiom,
-  const exprt &str,
+  const exprt &idx,
   const exprt &val)
 {
-  exprt idx=find_index(axiom.body(), str, axiom.univ_var());
-  if(idx.is_nil())
-    return true_exprt();
-
   exprt r=compute_inverse_function(stream, axiom.univ_var(), val, idx);
   implies_exprt instance(axiom.premise(), axiom.body());
   replace_expr(axiom.univ_var(), r, instance);
@@ -2492,6 +2536,72 @@ static optionalt<exprt> find_counter_example(
     return { };
 }
 
+/// Runs find_counter_example for each of \p queries, which are pairs of an
+/// axiom and a variable. With more than one job the queries are spread over
+/// worker processes, each with solvers of its own; the witnesses are passed
+/// back in serialized form.
+/// \return the witnesses, in the order of \p queries
+static std::vector<optionalt<exprt>> find_counter_examples(
+  const namespacet &ns,
+  const ui_message_handlert::uit ui,
+  const std::vector<std::pair<exprt, symbol_exprt>> &queries,
+  unsigned jobs)
+{
+  std::vector<optionalt<exprt>> witnesses;
+  witnesses.reserve(queries.size());
+
+  if(jobs<=1 || queries.size()<2 || !forked_tasks_supported())
+  {
+    for(const auto &query : queries)
+      witnesses.push_back(
+        find_counter_example(ns, ui, query.first, query.second));
+
+    return witnesses;
+  }
+
+  const auto worker=[&](std::size_t i) // NOLINT(whitespace/braces)
+  {
+    const auto witness=
+      find_counter_example(ns, ui, queries[i].first, queries[i].second);
+
+    if(!witness)
+      return std::string("0");
+
+    std::ostringstream out;
+    out << '1';
+    irep_serializationt::ireps_containert ic;
+    irep_serializationt(ic).reference_convert(*witness, out);
+    return out.str();
+  };
+
+  const std::vector<optionalt<std::string>> results=
+    run_forked_tasks(queries.size(), jobs, worker);
+
+  for(std::size_t i=0; i<queries.size(); i++)
+  {
+    const optionalt<std::string> &result=results[i];
+
+    if(!result || result->empty())
+    {
+      // the worker failed, search again here
+      witnesses.push_back(
+        find_counter_example(ns, ui, queries[i].first, queries[i].second));
+    }
+    else if((*result)[0]=='0')
+      witnesses.push_back({});
+    else
+    {
+      std::istringstream in(result->substr(1));
+      irep_serializationt::ireps_containert ic;
+      exprt witness;
+      irep_serializationt(ic).reference_convert(in, witness);
+      witnesses.push_back(witness);
+    }
+  }
+
+  return witnesses;
+}
+
 /// \related string_constraintt
 typedef std::map<exprt, std::vector<exprt>> array_index_mapt;
 
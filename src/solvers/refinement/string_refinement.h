@@ -41,6 +41,13 @@ struct string_axiomst
 {
   std::vector<string_constraintt> universal;
   std::vector<string_not_contains_constraintt> not_contains;
+
+  /// For each string, the universal axioms, by number, that index it with
+  /// an expression containing their quantified variable, together with the
+  /// first such expression. The axioms to instantiate for a new index of a
+  /// string are looked up here instead of being searched for.
+  std::map<exprt, std::vector<std::pair<std::size_t, exprt>>>
+    universal_by_string;
 };
 
 /// Represents arrays of the form `array_of(x) with {i:=a} with {j:=b} ...`
@@ -87,6 +94,8 @@ private:
     /// Concretize strings after solver is finished
     bool trace=false;
     bool use_counter_example=true;
+    /// Number of worker processes that check the axioms against a model
+    unsigned jobs=1;
   };
 public:
   /// string_refinementt constructor arguments
@@ -9,8 +9,13 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "dimacs_cnf.h"
 
+#include <iomanip>
 #include <iostream>
 
+// the width of the numbers in a problem line that is filled in later,
+// which fits any 64-bit number
+#define PROBLEM_LINE_WIDTH 20
+
 dimacs_cnft::dimacs_cnft():break_lines(false)
 {
 }
@@ -69,3 +74,37 @@ void dimacs_cnf_dumpt::lcnf(const bvt &bv)
 {
   write_dimacs_clause(bv, out, true);
 }
+
+dimacs_cnf_streamt::dimacs_cnf_streamt(std::ostream &_out):
+  out(_out),
+  clause_count(0)
+{
+  problem_line_position=out.tellp();
+  write_problem_line();
+}
+
+void dimacs_cnf_streamt::write_problem_line()
+{
+  const std::ostream::pos_type end=out.tellp();
+
+  out.seekp(problem_line_position);
+
+  // We start counting at 1, thus there is one variable fewer.
+  out << "p cnf "
+      << std::setw(PROBLEM_LINE_WIDTH) << (no_variables()-1) << " "
+      << std::setw(PROBLEM_LINE_WIDTH) << clause_count << "\n";
+
+  if(end!=problem_line_position)
+    out.seekp(end);
+}
+
+void dimacs_cnf_streamt::lcnf(const bvt &bv)
+{
+  bvt new_bv;
+
+  if(process_clause(bv, new_bv))
+    return;
+
+  write_dimacs_clause(new_bv, out, false);
+  clause_count++;
+}
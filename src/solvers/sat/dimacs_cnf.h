@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_SAT_DIMACS_CNF_H
 
 #include <iosfwd>
+#include <ostream>
 
 #include "cnf_clause_list.h"
 
@@ -68,4 +69,46 @@ protected:
   std::ostream &out;
 };
 
+/// Writes the clauses to a seekable stream as they are added, instead of
+/// keeping them in memory. The problem line is written first, with room
+/// for the numbers of variables and clauses, and is filled in by
+/// write_problem_line once these are known.
+class dimacs_cnf_streamt:public cnft
+{
+public:
+  explicit dimacs_cnf_streamt(std::ostream &_out);
+  virtual ~dimacs_cnf_streamt() { }
+
+  virtual const std::string solver_text()
+  {
+    return "DIMACS CNF (streamed)";
+  }
+
+  virtual void lcnf(const bvt &bv);
+
+  virtual resultt prop_solve()
+  {
+    return resultt::P_ERROR;
+  }
+
+  virtual tvt l_get(literalt) const
+  {
+    return tvt::unknown();
+  }
+
+  virtual size_t no_clauses() const
+  {
+    return clause_count;
+  }
+
+  /// Overwrites the problem line with the final numbers, and leaves the
+  /// stream at its end, e.g., for comments
+  void write_problem_line();
+
+protected:
+  std::ostream &out;
+  std::ostream::pos_type problem_line_position;
+  std::size_t clause_count;
+};
+
 #endif // CPROVER_SOLVERS_SAT_DIMACS_CNF_H
@@ -0,0 +1,175 @@
+/*******************************************************************\
+
+Module: Cube-and-Conquer over Forked SAT Solvers
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cube-and-Conquer over Forked SAT Solvers
+
+#include "satcheck_cube_and_conquer.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <util/forked_tasks.h>
+
+#include "satcheck.h"
+
+satcheck_cube_and_conquert::satcheck_cube_and_conquert(
+  unsigned _depth,
+  unsigned _jobs):
+  depth(_depth),
+  jobs(_jobs)
+{
+}
+
+const std::string satcheck_cube_and_conquert::solver_text()
+{
+  satcheckt solver;
+  return "cube-and-conquer with "+solver.solver_text();
+}
+
+/// \return the positive literals of the variables to split on, at most
+///   `depth` of them
+bvt satcheck_cube_and_conquert::get_split_variables() const
+{
+  std::vector<bool> taken(no_variables(), false);
+
+  // splitting on a variable that is assumed anyway gives an empty cube
+  forall_literals(it, assumptions)
+    if(!it->is_constant() && it->var_no()<taken.size())
+      taken[it->var_no()]=true;
+
+  bvt result;
+
+  forall_literals(it, split_literals)
+  {
+    if(result.size()>=depth)
+      return result;
+
+    if(it->is_constant() ||
+       it->var_no()>=taken.size() ||
+       taken[it->var_no()])
+      continue;
+
+    taken[it->var_no()]=true;
+    result.push_back(literalt(it->var_no(), false));
+  }
+
+  if(result.size()>=depth)
+    return result;
+
+  // top up with the variables that occur most often
+  std::vector<std::size_t> occurrences(no_variables(), 0);
+
+  for(const auto &clause : clauses)
+    forall_literals(it, clause)
+      if(!it->is_constant())
+        occurrences[it->var_no()]++;
+
+  std::vector<std::size_t> candidates;
+
+  for(std::size_t v=1; v<occurrences.size(); v++)
+    if(!taken[v] && occurrences[v]!=0)
+      candidates.push_back(v);
+
+  const std::size_t missing=
+    std::min(candidates.size(), std::size_t(depth)-result.size());
+
+  std::partial_sort(
+    candidates.begin(),
+    candidates.begin()+missing,
+    candidates.end(),
+    [&occurrences](std::size_t a, std::size_t b)
+    {
+      return occurrences[a]>occurrences[b];
+    });
+
+  for(std::size_t i=0; i<missing; i++)
+    result.push_back(literalt(candidates[i], false));
+
+  return result;
+}
+
+/// Runs in a child process
+std::string satcheck_cube_and_conquert::solve_cube(const bvt &cube) const
+{
+  satcheckt solver;
+
+  bvt cube_assumptions=assumptions;
+  cube_assumptions.insert(cube_assumptions.end(), cube.begin(), cube.end());
+
+  return solve_in_child(solver, cube_assumptions, nullptr);
+}
+
+propt::resultt satcheck_cube_and_conquert::prop_solve()
+{
+  const bvt split_variables=get_split_variables();
+  const std::size_t number_of_cubes=std::size_t(1)<<split_variables.size();
+  // hardware_concurrency may not know, and returns 0 then
+  const unsigned processes=
+    jobs!=0 ? jobs : std::max(std::thread::hardware_concurrency(), 1u);
+
+  status() << (no_variables()-1) << " variables, "
+           << clauses.size() << " clauses, "
+           << number_of_cubes << " cubes over "
+           << split_variables.size() << " variables" << eom;
+
+  // bit i of the cube number gives the phase of split variable i
+  const auto cube=[&split_variables](std::size_t number)
+  {
+    bvt result;
+    for(std::size_t i=0; i<split_variables.size(); i++)
+      result.push_back(split_variables[i]^(((number>>i)&1)!=0));
+    return result;
+  };
+
+  const std::vector<optionalt<std::string>> results=
+    run_forked_tasks(
+      number_of_cubes,
+      processes,
+      [this, &cube](std::size_t number)
+      {
+        return solve_cube(cube(number));
+      },
+      [](const std::string &result)
+      {
+        return !result.empty() && result[0]=='s';
+      });
+
+  std::size_t unsatisfiable=0;
+
+  for(std::size_t i=0; i<results.size(); i++)
+  {
+    if(!results[i].has_value() || results[i]->empty())
+      continue;
+
+    const std::string &result=*results[i];
+
+    if(result[0]=='u')
+      unsatisfiable++;
+    else if(result[0]=='s')
+    {
+      status() << "SAT checker: cube " << i << " is satisfiable" << eom;
+
+      set_assignment(result);
+
+      status() << "SAT checker: instance is SATISFIABLE" << eom;
+      return resultt::P_SATISFIABLE;
+    }
+  }
+
+  if(unsatisfiable==number_of_cubes)
+  {
+    status() << "SAT checker: all cubes are unsatisfiable" << eom;
+    status() << "SAT checker: instance is UNSATISFIABLE" << eom;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  status() << "SAT checker: " << (number_of_cubes-unsatisfiable)
+           << " cubes timed out or failed" << eom;
+  return resultt::P_ERROR;
+}
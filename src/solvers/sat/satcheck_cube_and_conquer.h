@@ -0,0 +1,57 @@
+/*******************************************************************\
+
+Module: Cube-and-Conquer over Forked SAT Solvers
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cube-and-Conquer over Forked SAT Solvers
+
+#ifndef CPROVER_SOLVERS_SAT_SATCHECK_CUBE_AND_CONQUER_H
+#define CPROVER_SOLVERS_SAT_SATCHECK_CUBE_AND_CONQUER_H
+
+#include <string>
+
+#include "satcheck_forked.h"
+
+/// Keeps the clauses, and for each call to prop_solve splits the formula on
+/// up to `depth` variables into `2^depth` cubes. Each cube is solved under
+/// assumptions by a solver of its own in a separate process. The formula
+/// is satisfiable as soon as one cube is, and unsatisfiable once all cubes
+/// are.
+///
+/// The variables to split on are taken from the split literals, in the
+/// order given, and are topped up with the variables that occur in the
+/// most clauses.
+class satcheck_cube_and_conquert:public satcheck_forkedt
+{
+public:
+  /// \param _depth: maximum number of variables to split on
+  /// \param _jobs: maximum number of concurrently running solvers, or 0 for
+  ///   as many as there are hardware threads
+  satcheck_cube_and_conquert(unsigned _depth, unsigned _jobs);
+  virtual ~satcheck_cube_and_conquert() { }
+
+  virtual const std::string solver_text() override;
+
+  virtual resultt prop_solve() override;
+
+  /// Sets the literals to split on first, e.g., the conditions of branches
+  /// that much of the formula depends on
+  void set_split_literals(const bvt &_split_literals)
+  {
+    split_literals=_split_literals;
+  }
+
+protected:
+  unsigned depth;
+  unsigned jobs;
+  bvt split_literals;
+
+  bvt get_split_variables() const;
+  std::string solve_cube(const bvt &cube) const;
+};
+
+#endif // CPROVER_SOLVERS_SAT_SATCHECK_CUBE_AND_CONQUER_H
@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: SAT Solvers Running in Child Processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// SAT Solvers Running in Child Processes
+
+#include "satcheck_forked.h"
+
+std::string satcheck_forkedt::solve_in_child(
+  cnft &solver,
+  const bvt &_assumptions,
+  const std::function<void(cnft &)> &configure) const
+{
+  // the output of the solvers would be interleaved
+  null_message_handlert message_handler;
+  solver.set_message_handler(message_handler);
+
+  copy_to(solver);
+
+  // the simplifier must not eliminate the variables of the assumptions
+  forall_literals(it, _assumptions)
+    if(!it->is_constant())
+      solver.set_frozen(*it);
+
+  if(configure)
+    configure(solver);
+
+  if(time_limit_seconds!=0)
+    solver.set_time_limit_seconds(time_limit_seconds);
+
+  solver.set_assumptions(_assumptions);
+
+  switch(solver.prop_solve())
+  {
+  case resultt::P_SATISFIABLE:
+  {
+    std::string result="s";
+    result.reserve(no_variables());
+
+    for(std::size_t v=1; v<no_variables(); v++)
+    {
+      const tvt value=solver.l_get(literalt(v, false));
+      result+=value.is_true()?'1':value.is_false()?'0':'?';
+    }
+
+    return result;
+  }
+
+  case resultt::P_UNSATISFIABLE:
+    return "u";
+
+  case resultt::P_ERROR:
+    break;
+  }
+
+  return "e";
+}
+
+void satcheck_forkedt::set_assignment(const std::string &answer)
+{
+  assignment.assign(no_variables(), tvt::unknown());
+
+  for(std::size_t v=1; v<no_variables() && v<answer.size(); v++)
+    if(answer[v]!='?')
+      assignment[v]=tvt(answer[v]=='1');
+}
@@ -0,0 +1,60 @@
+/*******************************************************************\
+
+Module: SAT Solvers Running in Child Processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// SAT Solvers Running in Child Processes
+
+#ifndef CPROVER_SOLVERS_SAT_SATCHECK_FORKED_H
+#define CPROVER_SOLVERS_SAT_SATCHECK_FORKED_H
+
+#include <functional>
+#include <string>
+
+#include "cnf_clause_list.h"
+
+/// Keeps the clauses, and hands a copy of them to solvers in child
+/// processes, which report their answers to the parent as text
+class satcheck_forkedt:public cnf_clause_list_assignmentt
+{
+public:
+  virtual void set_assumptions(const bvt &_assumptions) override
+  {
+    assumptions=_assumptions;
+  }
+
+  virtual bool has_set_assumptions() const override { return true; }
+
+  virtual void set_time_limit_seconds(uint32_t lim) override
+  {
+    time_limit_seconds=lim;
+  }
+
+protected:
+  satcheck_forkedt():time_limit_seconds(0)
+  {
+  }
+
+  bvt assumptions;
+  uint32_t time_limit_seconds;
+
+  /// Runs in a child process: copies the clauses to \p solver, configures
+  /// it with \p configure, if given, and solves them under \p
+  /// _assumptions
+  /// \return 's' followed by the values of the variables if the clauses are
+  ///   satisfiable, 'u' if they are not, and 'e' on error
+  std::string solve_in_child(
+    cnft &solver,
+    const bvt &_assumptions,
+    const std::function<void(cnft &)> &configure) const;
+
+  /// Takes the assignment from an answer of solve_in_child that starts
+  /// with 's'
+  void set_assignment(const std::string &answer);
+};
+
+#endif // CPROVER_SOLVERS_SAT_SATCHECK_FORKED_H
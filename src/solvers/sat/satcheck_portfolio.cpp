@@ -0,0 +1,140 @@
+/*******************************************************************\
+
+Module: Racing Several SAT Solvers on the Same CNF
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Racing Several SAT Solvers on the Same CNF
+
+#include "satcheck_portfolio.h"
+
+#include <type_traits>
+
+#include <util/forked_tasks.h>
+#include <util/make_unique.h>
+
+#include "satcheck.h"
+
+#ifdef HAVE_MINISAT2
+#include "satcheck_minisat2.h"
+#endif
+
+#ifdef HAVE_GLUCOSE
+#include "satcheck_glucose.h"
+#endif
+
+satcheck_portfoliot::satcheck_portfoliot(
+  const configurationst &_configurations):
+  configurations(_configurations)
+{
+}
+
+satcheck_portfoliot::configurationst
+satcheck_portfoliot::default_configurations()
+{
+  configurationst result;
+
+  result.push_back(
+    {"default solver with simplifier",
+     [] { return util_make_unique<satcheckt>(); },
+     nullptr});
+
+  if(!std::is_same<satcheckt, satcheck_no_simplifiert>::value)
+    result.push_back(
+      {"default solver without simplifier",
+       [] { return util_make_unique<satcheck_no_simplifiert>(); },
+       nullptr});
+
+  #ifdef HAVE_MINISAT2
+  // MiniSat tries false first unless told otherwise; its polarity is the
+  // sign of the literal tried first, hence false asks for true
+  result.push_back(
+    {"MiniSAT 2 preferring true",
+     [] { return util_make_unique<satcheck_minisat_no_simplifiert>(); },
+     [](cnft &solver)
+     {
+       auto &minisat=static_cast<satcheck_minisat_no_simplifiert &>(solver);
+       for(std::size_t v=1; v<minisat.no_variables(); v++)
+         minisat.set_polarity(literalt(v, false), false);
+     }});
+  #endif
+
+  #ifdef HAVE_GLUCOSE
+  if(!std::is_same<satcheckt, satcheck_glucose_simplifiert>::value)
+    result.push_back(
+      {"Glucose with simplifier",
+       [] { return util_make_unique<satcheck_glucose_simplifiert>(); },
+       nullptr});
+  #endif
+
+  return result;
+}
+
+const std::string satcheck_portfoliot::solver_text()
+{
+  std::string result="portfolio of";
+
+  for(const auto &c : configurations)
+    result+=(&c==&configurations.front()?" ":", ")+c.name;
+
+  return result;
+}
+
+/// Runs in a child process
+std::string satcheck_portfoliot::solve_with(std::size_t configuration) const
+{
+  const configurationt &c=configurations[configuration];
+  std::unique_ptr<cnft> solver=c.make_solver();
+
+  return solve_in_child(*solver, assumptions, c.configure);
+}
+
+propt::resultt satcheck_portfoliot::prop_solve()
+{
+  status() << (no_variables()-1) << " variables, "
+           << clauses.size() << " clauses, "
+           << configurations.size() << " solvers" << eom;
+
+  const auto is_answer=[](const std::string &result)
+  {
+    return !result.empty() && result[0]!='e';
+  };
+
+  const std::vector<optionalt<std::string>> results=
+    run_forked_tasks(
+      configurations.size(),
+      configurations.size(),
+      [this](std::size_t configuration)
+      {
+        return solve_with(configuration);
+      },
+      is_answer);
+
+  for(std::size_t i=0; i<results.size(); i++)
+  {
+    if(!results[i].has_value() || !is_answer(*results[i]))
+      continue;
+
+    const std::string &result=*results[i];
+
+    status() << "SAT checker: " << configurations[i].name
+             << " answered first" << eom;
+
+    if(result[0]=='u')
+    {
+      status() << "SAT checker: instance is UNSATISFIABLE" << eom;
+      return resultt::P_UNSATISFIABLE;
+    }
+
+    set_assignment(result);
+
+    status() << "SAT checker: instance is SATISFIABLE" << eom;
+    return resultt::P_SATISFIABLE;
+  }
+
+  status() << "SAT checker: timed out or other error" << eom;
+  return resultt::P_ERROR;
+}
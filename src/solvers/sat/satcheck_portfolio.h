@@ -0,0 +1,58 @@
+/*******************************************************************\
+
+Module: Racing Several SAT Solvers on the Same CNF
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Racing Several SAT Solvers on the Same CNF
+
+#ifndef CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
+#define CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "satcheck_forked.h"
+
+/// Keeps the clauses, and for each call to prop_solve hands a copy of them
+/// to several differently configured solvers, each in its own process. The
+/// first of them to find the formula satisfiable or unsatisfiable wins, and
+/// the others are killed.
+///
+/// Every call to prop_solve starts the solvers from scratch, hence nothing
+/// learnt in one call is kept for the next.
+class satcheck_portfoliot:public satcheck_forkedt
+{
+public:
+  /// Creates a solver, and configures it once it holds the clauses
+  struct configurationt
+  {
+    std::string name;
+    std::function<std::unique_ptr<cnft>()> make_solver;
+    std::function<void(cnft &)> configure;
+  };
+
+  typedef std::vector<configurationt> configurationst;
+
+  explicit satcheck_portfoliot(const configurationst &_configurations);
+  virtual ~satcheck_portfoliot() { }
+
+  /// \return the configurations of the solvers this build links against
+  static configurationst default_configurations();
+
+  virtual const std::string solver_text() override;
+
+  virtual resultt prop_solve() override;
+
+protected:
+  configurationst configurations;
+
+  std::string solve_with(std::size_t configuration) const;
+};
+
+#endif // CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
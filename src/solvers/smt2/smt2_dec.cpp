@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "smt2_dec.h"
 
+#include <csignal>
 #include <cstdlib>
 
 #if defined(__linux__) || \
@@ -24,9 +25,31 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/tempfile.h>
 #include <util/arith_tools.h>
 #include <util/ieee_float.h>
+#include <util/invariant.h>
+#include <util/make_unique.h>
 
 #include "smt2irep.h"
 
+/// Ignores SIGPIPE while in scope, such that writing to a solver process
+/// that has terminated fails the stream rather than terminating us
+class ignore_sigpipet
+{
+public:
+#ifdef SIGPIPE
+  ignore_sigpipet():previous(signal(SIGPIPE, SIG_IGN))
+  {
+  }
+
+  ~ignore_sigpipet()
+  {
+    signal(SIGPIPE, previous);
+  }
+
+protected:
+  void (*previous)(int);
+#endif
+};
+
 std::string smt2_dect::decision_procedure_text() const
 {
   return "SMT2 "+logic+
@@ -63,13 +86,67 @@ smt2_temp_filet::~smt2_temp_filet()
     unlink(temp_result_filename.c_str());
 }
 
+smt2_dect::~smt2_dect()
+{
+  // a solver whose pipe has failed is gone and cannot be told to exit
+  if(process && *process)
+  {
+    ignore_sigpipet ignore_sigpipe;
+    *process << "(exit)\n" << std::flush;
+    process->wait();
+  }
+}
+
 decision_proceduret::resultt smt2_dect::dec_solve()
+{
+  // the formula sent to a solver that has been lost is not kept, hence it
+  // cannot be solved any more
+  if(process && !*process)
+  {
+    error() << "SMT2 solver is no longer running" << eom;
+    return resultt::D_ERROR;
+  }
+
+  if(interactive && !process)
+  {
+    std::string executable;
+    std::list<std::string> arguments;
+
+    if(!interactive_solver_arguments(executable, arguments))
+    {
+      warning() << "SMT2 solver cannot be run interactively, "
+                << "using a file for each query" << eom;
+      interactive=false;
+    }
+    else
+    {
+      process=util_make_unique<pipe_streamt>(executable, arguments);
+
+      if(process->run()<0)
+      {
+        warning() << "failed to start " << executable << ", "
+                  << "using a file for each query" << eom;
+        process.reset();
+        interactive=false;
+      }
+    }
+  }
+
+  if(interactive)
+    return dec_solve_interactive();
+  else
+    return dec_solve_file();
+}
+
+decision_proceduret::resultt smt2_dect::dec_solve_file()
 {
   // we write the problem into a file
   smt2_temp_filet smt2_temp_file;
 
-  // copy from string buffer into file
-  smt2_temp_file.temp_out << stringstream.str();
+  // copy from string buffer into file, without a copy of the buffer
+  stringstream.seekg(0);
+  if(stringstream.rdbuf()->in_avail()>0)
+    smt2_temp_file.temp_out << stringstream.rdbuf();
 
   // this finishes up and closes the SMT2 file
   write_footer(smt2_temp_file.temp_out);
@@ -177,7 +254,6 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
   boolean_assignment.clear();
   boolean_assignment.resize(no_boolean_variables, false);
 
-  typedef std::unordered_map<irep_idt, irept, irep_id_hash> valuest;
   valuest values;
 
   while(in)
@@ -218,6 +294,13 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     }
   }
 
+  set_values(values);
+
+  return res;
+}
+
+void smt2_dect::set_values(valuest &values)
+{
   for(auto &assignment : identifier_map)
   {
     std::string conv_id=convert_identifier(assignment.first);
@@ -231,6 +314,159 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     const irept &value=values["B"+std::to_string(v)];
     boolean_assignment[v]=(value.id()==ID_true);
   }
+}
+
+/// Gives the command line that makes the solver read commands from its
+/// standard input and answer each of them as soon as it has been read
+/// \return false if the solver cannot be run this way
+bool smt2_dect::interactive_solver_arguments(
+  std::string &executable,
+  std::list<std::string> &arguments) const
+{
+  switch(solver)
+  {
+  case solvert::CVC4:
+    executable="cvc4";
+    arguments={"-L", "smt2", "--incremental"};
+    return true;
+
+  case solvert::MATHSAT:
+    executable="mathsat";
+    arguments={"-input=smt2"};
+    return true;
+
+  case solvert::YICES:
+    executable="yices-smt2";
+    arguments={"--incremental"};
+    return true;
+
+  case solvert::Z3:
+    executable="z3";
+    arguments={"-smt2", "-in"};
+    return true;
+
+  case solvert::GENERIC:
+  case solvert::BOOLECTOR: // doesn't answer get-value
+  case solvert::CVC3:
+  case solvert::OPENSMT:
+    return false;
+  }
+
+  UNREACHABLE;
+}
+
+/// Sends what has been added to the formula since the previous call to the
+/// solver process, and asks it about the assumptions within a scope of its
+/// own, so that neither the assumptions nor the object sizes, which may
+/// change as more objects are added, outlive this call
+decision_proceduret::resultt smt2_dect::dec_solve_interactive()
+{
+  ignore_sigpipet ignore_sigpipe;
+
+  out << "\n(push 1)\n";
+
+  // the object sizes are fixed only for the objects known so far
+  for(const auto &object : object_sizes)
+    define_object_size(object.second, object.first);
+
+  if(assumptions.empty())
+    out << "(check-sat)\n";
+  else
+  {
+    out << "(check-sat-assuming (";
+
+    forall_literals(it, assumptions)
+    {
+      out << " ";
+      convert_literal(*it);
+    }
+
+    out << "))\n";
+  }
+
+  // the text sent is no longer kept
+  *process << stringstream.str() << std::flush;
+  stringstream.str(std::string());
+
+  if(!*process)
+  {
+    error() << "failed to send formula to SMT2 solver" << eom;
+    return resultt::D_ERROR;
+  }
+
+  const resultt res=read_interactive_result();
+
+  *process << "(pop 1)\n" << std::flush;
+
+  return res;
+}
+
+/// Reads the answer to check-sat, and, if satisfiable, asks for the values
+/// of all identifiers in one get-value command, whose answer is then read
+/// pair by pair
+decision_proceduret::resultt smt2_dect::read_interactive_result()
+{
+  boolean_assignment.clear();
+  boolean_assignment.resize(no_boolean_variables, false);
+
+  resultt res=resultt::D_ERROR;
+
+  while(res==resultt::D_ERROR)
+  {
+    irept parsed=smt2irep(*process);
+
+    if(!*process)
+    {
+      error() << "SMT2 solver terminated unexpectedly" << eom;
+      return resultt::D_ERROR;
+    }
+    else if(parsed.id()=="sat")
+      res=resultt::D_SATISFIABLE;
+    else if(parsed.id()=="unsat")
+      res=resultt::D_UNSATISFIABLE;
+    else if(parsed.id()=="unknown")
+    {
+      error() << "SMT2 solver returned unknown" << eom;
+      return resultt::D_ERROR;
+    }
+    else if(parsed.id()=="" &&
+            parsed.get_sub().size()==2 &&
+            parsed.get_sub().front().id()=="error")
+    {
+      error() << "SMT2 solver returned error message:\n"
+              << "\t\"" << parsed.get_sub()[1].id() <<"\"" << eom;
+      return resultt::D_ERROR;
+    }
+    // anything else, e.g., "unsupported", is not an answer to check-sat
+  }
+
+  if(res!=resultt::D_SATISFIABLE || smt2_identifiers.empty())
+    return res;
+
+  *process << "(get-value (";
+  for(const auto &id : smt2_identifiers)
+    *process << " |" << id << "|";
+  *process << "))\n" << std::flush;
+
+  irept parsed=smt2irep(*process);
+
+  if(!*process || parsed.id()!="")
+  {
+    error() << "SMT2 solver did not answer get-value" << eom;
+    return resultt::D_ERROR;
+  }
+
+  // Example:
+  // ( (B0 true) (|__CPROVER_pipe_count#1| (_ bv0 32)) )
+  valuest values;
+
+  for(const auto &pair : parsed.get_sub())
+  {
+    if(pair.get_sub().size()==2)
+      values[pair.get_sub()[0].id()]=pair.get_sub()[1];
+  }
+
+  set_values(values);
 
   return res;
 }
@@ -11,6 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_SMT2_SMT2_DEC_H
 
 #include <fstream>
+#include <memory>
+#include <unordered_map>
+
+#include <util/pipe_stream.h>
 
 #include "smt2_conv.h"
 
@@ -41,18 +45,39 @@ public:
     const std::string &_notes,
     const std::string &_logic,
     solvert _solver):
-    smt2_convt(_ns, _benchmark, _notes, _logic, _solver, stringstream)
+    smt2_convt(_ns, _benchmark, _notes, _logic, _solver, stringstream),
+    interactive(false)
   {
   }
 
+  virtual ~smt2_dect();
+
   virtual resultt dec_solve();
   virtual std::string decision_procedure_text() const;
 
   // yes, we are incremental!
   virtual bool has_set_assumptions() const { return true; }
 
+  /// Keep one solver process for all calls to dec_solve, and feed it only
+  /// what has been added to the formula since the previous call. Solvers
+  /// that cannot be run this way are run on a file for each call.
+  bool interactive;
+
 protected:
+  typedef std::unordered_map<irep_idt, irept, irep_id_hash> valuest;
+
   resultt read_result(std::istream &in);
+  void set_values(valuest &values);
+
+  // the solver process in interactive mode
+  std::unique_ptr<pipe_streamt> process;
+
+  bool interactive_solver_arguments(
+    std::string &executable,
+    std::list<std::string> &arguments) const;
+  resultt dec_solve_file();
+  resultt dec_solve_interactive();
+  resultt read_interactive_result();
 };
 
 #endif // CPROVER_SOLVERS_SMT2_SMT2_DEC_H
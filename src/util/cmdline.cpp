@@ -26,6 +26,28 @@ void cmdlinet::clear()
   args.clear();
 }
 
+std::string cmdlinet::options_as_string(
+  const std::set<std::string> &ignored) const
+{
+  std::string result;
+
+  for(const auto &option : options)
+  {
+    const std::string name=
+      option.islong ? option.optstring : std::string(1, option.optchar);
+
+    if(!option.isset || ignored.find(name)!=ignored.end())
+      continue;
+
+    result+=name;
+    for(const auto &value : option.values)
+      result+=" "+value;
+    result+='\n';
+  }
+
+  return result;
+}
+
 bool cmdlinet::isset(char option) const
 {
   int i=getoptnr(option);
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <vector>
 #include <list>
+#include <set>
 #include <string>
 
 class cmdlinet
@@ -31,6 +32,11 @@ public:
   virtual void set(const std::string &option, const std::string &value);
   virtual void clear();
 
+  /// \return one line for each option that is set, giving its name and
+  ///   values, in the order in which the options were declared; options
+  ///   named in \p ignored are left out
+  std::string options_as_string(const std::set<std::string> &ignored) const;
+
   typedef std::vector<std::string> argst;
   argst args;
   std::string unknown_arg;
@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Pool allocator for objects of a fixed size
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Pool allocator for objects of a fixed size
+
+#include "fixed_size_pool.h"
+
+#include <algorithm>
+#include <new>
+#include <ostream>
+
+#include "invariant.h"
+
+/// Round \p size up such that consecutive blocks are suitably aligned for
+/// any object, and can hold a free-list link.
+static std::size_t aligned_block_size(std::size_t size)
+{
+  const std::size_t alignment=alignof(std::max_align_t);
+  size=std::max(size, sizeof(void *));
+  return (size+alignment-1)/alignment*alignment;
+}
+
+fixed_size_poolt::fixed_size_poolt(
+  std::size_t block_size,
+  std::size_t _blocks_per_chunk):
+  size(aligned_block_size(block_size)),
+  blocks_per_chunk(std::max<std::size_t>(_blocks_per_chunk, 1)),
+  free_list(nullptr)
+{
+}
+
+fixed_size_poolt::~fixed_size_poolt()
+{
+  for(char *chunk : chunks)
+    ::operator delete(chunk);
+}
+
+void fixed_size_poolt::add_chunk()
+{
+  // ::operator new returns memory aligned for any object
+  char *chunk=static_cast<char *>(::operator new(size*blocks_per_chunk));
+  chunks.push_back(chunk);
+  ++statistics.chunks;
+
+  // thread the new blocks onto the free list, lowest address first
+  for(std::size_t i=blocks_per_chunk; i>0; i--)
+  {
+    free_blockt *block=reinterpret_cast<free_blockt *>(chunk+(i-1)*size);
+    block->next=free_list;
+    free_list=block;
+  }
+}
+
+void *fixed_size_poolt::allocate()
+{
+  if(free_list==nullptr)
+    add_chunk();
+
+  free_blockt *block=free_list;
+  free_list=block->next;
+
+  ++statistics.allocations;
+  statistics.peak_live=std::max(statistics.peak_live, statistics.live());
+
+  return block;
+}
+
+void fixed_size_poolt::deallocate(void *p)
+{
+  if(p==nullptr)
+    return;
+
+  PRECONDITION(statistics.live()>0);
+
+  free_blockt *block=static_cast<free_blockt *>(p);
+  block->next=free_list;
+  free_list=block;
+
+  ++statistics.deallocations;
+}
+
+void fixed_size_poolt::output_statistics(std::ostream &out) const
+{
+  out << "  block size: " << size << "\n";
+  out << "  allocations: " << statistics.allocations << "\n";
+  out << "  deallocations: " << statistics.deallocations << "\n";
+  out << "  live blocks: " << statistics.live() << "\n";
+  out << "  peak live blocks: " << statistics.peak_live << "\n";
+  out << "  chunks: " << statistics.chunks << "\n";
+  out << "  space reserved: "
+      << statistics.chunks*blocks_per_chunk*size << "\n";
+}
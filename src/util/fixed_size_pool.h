@@ -0,0 +1,85 @@
+/*******************************************************************\
+
+Module: Pool allocator for objects of a fixed size
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Pool allocator for objects of a fixed size
+
+#ifndef CPROVER_UTIL_FIXED_SIZE_POOL_H
+#define CPROVER_UTIL_FIXED_SIZE_POOL_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+/// \brief Hands out blocks of one fixed size, carved from large chunks
+///
+/// Freed blocks are kept on a free list for re-use and are never returned
+/// to the operating system. This avoids the per-allocation overhead of the
+/// general-purpose heap, and keeps objects of the same kind close to each
+/// other, for large numbers of small, short-lived objects such as irep
+/// nodes. Not thread-safe.
+class fixed_size_poolt
+{
+public:
+  /// \param block_size: size of each block handed out, in bytes
+  /// \param blocks_per_chunk: number of blocks allocated from the heap at
+  ///   once when the free list is empty
+  explicit fixed_size_poolt(
+    std::size_t block_size,
+    std::size_t blocks_per_chunk=4096);
+
+  ~fixed_size_poolt();
+
+  fixed_size_poolt(const fixed_size_poolt &)=delete;
+  fixed_size_poolt &operator=(const fixed_size_poolt &)=delete;
+
+  void *allocate();
+  void deallocate(void *);
+
+  std::size_t block_size() const
+  {
+    return size;
+  }
+
+  struct statisticst
+  {
+    std::size_t allocations=0;
+    std::size_t deallocations=0;
+    std::size_t peak_live=0;
+    std::size_t chunks=0;
+
+    std::size_t live() const
+    {
+      return allocations-deallocations;
+    }
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+  void output_statistics(std::ostream &) const;
+
+protected:
+  /// A free block holds the pointer to the next free block
+  struct free_blockt
+  {
+    free_blockt *next;
+  };
+
+  const std::size_t size;
+  const std::size_t blocks_per_chunk;
+  free_blockt *free_list;
+  std::vector<char *> chunks;
+  statisticst statistics;
+
+  void add_chunk();
+};
+
+#endif // CPROVER_UTIL_FIXED_SIZE_POOL_H
@@ -0,0 +1,267 @@
+/*******************************************************************\
+
+Module: Run independent tasks in forked worker processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Run independent tasks in forked worker processes
+
+#include "forked_tasks.h"
+
+#include <iostream>
+#include <map>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdio>
+
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#include "signal_catcher.h"
+
+bool forked_tasks_supported()
+{
+  #ifdef _WIN32
+  return false;
+  #else
+  return true;
+  #endif
+}
+
+std::vector<optionalt<std::string>> run_forked_tasks(
+  std::size_t number_of_tasks,
+  unsigned jobs,
+  const forked_taskt &task)
+{
+  return run_forked_tasks(
+    number_of_tasks,
+    jobs,
+    task,
+    [](const std::string &) { return false; });
+}
+
+#ifdef _WIN32
+
+std::vector<optionalt<std::string>> run_forked_tasks(
+  std::size_t number_of_tasks,
+  unsigned,
+  const forked_taskt &task,
+  const forked_tasks_donet &done)
+{
+  std::vector<optionalt<std::string>> results(number_of_tasks);
+
+  for(std::size_t i=0; i<number_of_tasks; i++)
+  {
+    try
+    {
+      results[i]=task(i);
+    }
+    catch(...)
+    {
+      continue;
+    }
+
+    if(done(*results[i]))
+      break;
+  }
+
+  return results;
+}
+
+#else
+
+/// Book-keeping for a child process that has not yet terminated
+struct forked_childt
+{
+  pid_t pid;
+  std::size_t task_number;
+  std::string output;
+};
+
+/// Body of the child process; never returns
+static void run_child(
+  int fd,
+  std::size_t task_number,
+  const forked_taskt &task)
+{
+  remove_signal_catcher();
+
+  int exit_code=0;
+
+  try
+  {
+    const std::string output=task(task_number);
+    const char *data=output.data();
+    std::size_t remaining=output.size();
+
+    while(remaining>0)
+    {
+      ssize_t written=write(fd, data, remaining);
+      if(written==-1)
+      {
+        if(errno==EINTR)
+          continue;
+        exit_code=1;
+        break;
+      }
+      data+=written;
+      remaining-=written;
+    }
+  }
+  catch(...)
+  {
+    exit_code=1;
+  }
+
+  std::cout.flush();
+  std::cerr.flush();
+  close(fd);
+
+  // skip destructors and atexit handlers, which belong to the parent
+  _exit(exit_code);
+}
+
+std::vector<optionalt<std::string>> run_forked_tasks(
+  std::size_t number_of_tasks,
+  unsigned jobs,
+  const forked_taskt &task,
+  const forked_tasks_donet &done)
+{
+  std::vector<optionalt<std::string>> results(number_of_tasks);
+
+  if(jobs==0)
+    jobs=1;
+
+  // read end of the pipe -> child
+  std::map<int, forked_childt> running;
+  std::size_t next_task=0;
+
+  while(next_task<number_of_tasks || !running.empty())
+  {
+    while(running.size()<jobs && next_task<number_of_tasks)
+    {
+      const std::size_t task_number=next_task++;
+
+      int fds[2];
+      if(pipe(fds)==-1)
+      {
+        perror("Failed to create pipe for worker process");
+        continue;
+      }
+
+      // don't let the child inherit (and later re-emit) buffered output
+      std::cout.flush();
+      std::cerr.flush();
+
+      pid_t pid=fork();
+
+      if(pid==-1)
+      {
+        perror("Failed to fork worker process");
+        close(fds[0]);
+        close(fds[1]);
+      }
+      else if(pid==0)
+      {
+        close(fds[0]);
+        for(const auto &r : running)
+          close(r.first);
+        run_child(fds[1], task_number, task);
+      }
+      else
+      {
+        close(fds[1]);
+        running[fds[0]]=forked_childt{pid, task_number, std::string()};
+      }
+    }
+
+    if(running.empty())
+      continue;
+
+    std::vector<pollfd> poll_fds;
+    poll_fds.reserve(running.size());
+    for(const auto &r : running)
+      poll_fds.push_back(pollfd{r.first, POLLIN, 0});
+
+    if(poll(poll_fds.data(), poll_fds.size(), -1)==-1)
+    {
+      if(errno==EINTR)
+        continue;
+      perror("Failed to wait for worker processes");
+      // give up on the running children, but still reap them below
+      for(auto &p : poll_fds)
+        p.revents=POLLHUP;
+    }
+
+    for(const auto &p : poll_fds)
+    {
+      if(p.revents==0)
+        continue;
+
+      forked_childt &child=running[p.fd];
+
+      char buffer[4096];
+      ssize_t n=read(p.fd, buffer, sizeof(buffer));
+
+      if(n>0)
+      {
+        child.output.append(buffer, n);
+        continue;
+      }
+
+      if(n==-1 && errno==EINTR)
+        continue;
+
+      // end of file (or error): collect the child
+      close(p.fd);
+
+      int status=0;
+      pid_t waited;
+      do
+        waited=waitpid(child.pid, &status, 0);
+      while(waited==-1 && errno==EINTR);
+
+      const bool finished=
+        n==0 &&
+        waited==child.pid &&
+        WIFEXITED(status) &&
+        WEXITSTATUS(status)==0;
+
+      if(finished)
+        results[child.task_number]=child.output;
+
+      const bool stop=finished && done(child.output);
+
+      running.erase(p.fd);
+
+      if(stop)
+      {
+        next_task=number_of_tasks;
+
+        for(const auto &r : running)
+        {
+          kill(r.second.pid, SIGKILL);
+          close(r.first);
+          while(waitpid(r.second.pid, nullptr, 0)==-1 && errno==EINTR)
+          {
+          }
+        }
+
+        running.clear();
+        break;
+      }
+    }
+  }
+
+  return results;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*******************************************************************\
+
+Module: Run independent tasks in forked worker processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Run independent tasks in forked worker processes
+///
+/// The irept reference counts and the global string table are not
+/// thread-safe, so parallel work over expressions and solvers must not
+/// share an address space. Forking gives each worker a copy-on-write
+/// snapshot of everything the parent has built so far (e.g., a solver that
+/// has already been handed the formula) at very little cost.
+
+#ifndef CPROVER_UTIL_FORKED_TASKS_H
+#define CPROVER_UTIL_FORKED_TASKS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "optional.h"
+
+/// A task is given its index and returns its result as a string, which is
+/// passed back to the parent process through a pipe.
+typedef std::function<std::string(std::size_t)> forked_taskt;
+
+/// Runs `task(0)`, ..., `task(number_of_tasks-1)`, each in its own child
+/// process, with at most \p jobs children alive at any time. Changes a task
+/// makes to the program state are not visible to the parent or to other
+/// tasks.
+/// \param number_of_tasks: number of tasks to run
+/// \param jobs: maximum number of concurrently running processes
+/// \param task: the task, which is invoked in the child process
+/// \return The result of each task, indexed by task number. An entry is
+///   empty if the child process did not terminate normally, e.g., because
+///   the task threw an exception or the child was killed.
+/// \remarks On platforms without fork() the tasks are run one after another
+///   in the calling process, and their side effects are therefore visible.
+std::vector<optionalt<std::string>> run_forked_tasks(
+  std::size_t number_of_tasks,
+  unsigned jobs,
+  const forked_taskt &task);
+
+/// Decides, given the result of a task, whether the remaining tasks are
+/// no longer needed
+typedef std::function<bool(const std::string &)> forked_tasks_donet;
+
+/// Like run_forked_tasks() above, but as soon as a task returns a result
+/// for which \p done holds, the children that are still running are killed
+/// and no further tasks are started. The results of these tasks are empty.
+/// This races tasks that compute the same thing in different ways.
+std::vector<optionalt<std::string>> run_forked_tasks(
+  std::size_t number_of_tasks,
+  unsigned jobs,
+  const forked_taskt &task,
+  const forked_tasks_donet &done);
+
+/// \return true if run_forked_tasks() isolates tasks in separate processes
+bool forked_tasks_supported();
+
+#endif // CPROVER_UTIL_FORKED_TASKS_H
@@ -26,6 +26,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #endif
 
+#ifdef IREP_POOL
+#include "fixed_size_pool.h"
+#endif
+
 #ifdef SUB_IS_LIST
 static inline bool named_subt_order(
   const std::pair<irep_namet, irept> &a,
@@ -204,9 +208,41 @@ irept &irept::add(const irep_namet &name, const irept &irep)
   #endif
 }
 
+#ifdef IREP_POOL
+// Allocated on first use and never destroyed, as ireps with static storage
+// duration may be released after any static pool object has gone.
+static fixed_size_poolt *irep_pool=nullptr;
+
+void *irept::dt::operator new(std::size_t size)
+{
+  if(size!=sizeof(dt))
+    return ::operator new(size);
+
+  if(irep_pool==nullptr)
+    irep_pool=new fixed_size_poolt(sizeof(dt));
+
+  return irep_pool->allocate();
+}
+
+void irept::dt::operator delete(void *p, std::size_t size)
+{
+  if(size!=sizeof(dt))
+    ::operator delete(p);
+  else
+    irep_pool->deallocate(p);
+}
+
+void output_irep_pool_statistics(std::ostream &out)
+{
+  if(irep_pool!=nullptr)
+    irep_pool->output_statistics(out);
+}
+#endif
+
 #ifdef IREP_HASH_STATS
 unsigned long long irep_cmp_cnt=0;
 unsigned long long irep_cmp_ne_cnt=0;
+unsigned long long irep_cmp_ptr_cnt=0;
 #endif
 
 bool irept::operator==(const irept &other) const
@@ -216,10 +252,16 @@ bool irept::operator==(const irept &other) const
   #endif
   #ifdef SHARING
   if(data==other.data)
+  {
+    #ifdef IREP_HASH_STATS
+    ++irep_cmp_ptr_cnt;
+    #endif
     return true;
+  }
   #endif
 
-  if(id()!=other.id() ||
+  if(hash_codes_differ(other) ||
+     id()!=other.id() ||
      get_sub()!=other.get_sub() || // recursive call
      get_named_sub()!=other.get_named_sub()) // recursive call
   {
@@ -241,7 +283,8 @@ bool irept::full_eq(const irept &other) const
     return true;
   #endif
 
-  if(id()!=other.id())
+  // hash() disregards comments only, so different hashes imply inequality
+  if(hash_codes_differ(other) || id()!=other.id())
     return false;
 
   const irept::subt &i1_sub=get_sub();
@@ -434,6 +477,15 @@ std::size_t irept::hash() const
   #ifdef HASH_CODE
   if(read().hash_code!=0)
     return read().hash_code;
+
+  // A node that is not shareable may have mutable references into it
+  // outstanding, which allow changing the tree without calling write() on
+  // this node. Only cache if neither this node nor any child is affected.
+  #ifdef SHARING
+  bool cache=read().is_shareable();
+  #else
+  bool cache=true;
+  #endif
   #endif
 
   const irept::subt &sub=get_sub();
@@ -441,18 +493,28 @@ std::size_t irept::hash() const
 
   std::size_t result=hash_string(id());
 
-  forall_irep(it, sub) result=hash_combine(result, it->hash());
+  forall_irep(it, sub)
+  {
+    result=hash_combine(result, it->hash());
+    #ifdef HASH_CODE
+    cache=cache && it->read().hash_code!=0;
+    #endif
+  }
 
   forall_named_irep(it, named_sub)
   {
     result=hash_combine(result, hash_string(it->first));
     result=hash_combine(result, it->second.hash());
+    #ifdef HASH_CODE
+    cache=cache && it->second.read().hash_code!=0;
+    #endif
   }
 
   result=hash_finalize(result, named_sub.size()+sub.size());
 
   #ifdef HASH_CODE
-  read().hash_code=result;
+  if(cache)
+    read().hash_code=result;
   #endif
   #ifdef IREP_HASH_STATS
   ++irep_hash_cnt;
@@ -18,7 +18,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "irep_ids.h"
 
 #define SHARING
+// Cache hash() in each node and use it to refute equality quickly; build
+// with -DHASH_CODE to enable. Combined with merge_irept, which then
+// hash-conses trees, equal ireps share one node and operator== reduces to
+// comparing pointers and cached hashes.
 // #define HASH_CODE
+// Allocate nodes from a fixed_size_poolt rather than one by one from the
+// heap; build with -DIREP_POOL to enable
+// #define IREP_POOL
 // #define SUB_IS_LIST
 
 #ifdef SHARING
@@ -216,6 +223,11 @@ private:
     mutable std::size_t hash_code = 0;
     #endif
 
+    #ifdef IREP_POOL
+    static void *operator new(std::size_t);
+    static void operator delete(void *, std::size_t);
+    #endif
+
     void clear()
     {
       data.clear();
@@ -237,9 +249,26 @@ private:
   dt &write(bool mark_shareable)
   {
 #ifdef SHARING
-    return data.write(mark_shareable);
+    dt &d=data.write(mark_shareable);
 #else
-    return data;
+    dt &d=data;
+#endif
+#ifdef HASH_CODE
+    // the caller may change the contents, invalidating the cached hash
+    d.hash_code=0;
+#endif
+    return d;
+  }
+
+  bool hash_codes_differ(const irept &other) const
+  {
+#ifdef HASH_CODE
+    return read().hash_code!=0 &&
+           other.read().hash_code!=0 &&
+           read().hash_code!=other.read().hash_code;
+#else
+    (void)other; // unused parameter
+    return false;
 #endif
   }
 
@@ -254,6 +283,10 @@ public:
   }
 };
 
+#ifdef IREP_POOL
+void output_irep_pool_statistics(std::ostream &);
+#endif
+
 // NOLINTNEXTLINE(readability/identifiers)
 struct irep_hash
 {
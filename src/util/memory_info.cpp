@@ -25,6 +25,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <ostream>
 
+#include "irep.h"
+
 void memory_info(std::ostream &out)
 {
   #if defined(__linux__) && defined(__GLIBC__)
@@ -68,4 +70,9 @@ void memory_info(std::ostream &out)
   out << "  size_allocated: "
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
   #endif
+
+  #ifdef IREP_POOL
+  out << "  irep node pool:\n";
+  output_irep_pool_statistics(out);
+  #endif
 }
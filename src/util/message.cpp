@@ -9,6 +9,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "message.h"
 
+#include "string2int.h"
+
 void message_handlert::print(
   unsigned level,
   const std::string &message,
@@ -66,3 +68,25 @@ void message_handlert::print(
 messaget::~messaget()
 {
 }
+
+void recording_message_handlert::replay(
+  const std::string &recording,
+  std::size_t pos,
+  message_handlert &dest)
+{
+  while(pos<recording.size())
+  {
+    const std::size_t space=recording.find(' ', pos);
+    const std::size_t newline=recording.find('\n', space);
+    if(space==std::string::npos || newline==std::string::npos)
+      return;
+
+    const unsigned level=
+      unsafe_string2unsigned(recording.substr(pos, space-pos));
+    const std::size_t length=
+      unsafe_string2size_t(recording.substr(space+1, newline-space-1));
+
+    dest.print(level, recording.substr(newline+1, length));
+    pos=newline+1+length;
+  }
+}
@@ -111,6 +111,41 @@ protected:
   std::ostream &out;
 };
 
+/// Keeps the messages of a worker process so that the parent can replay
+/// them in a deterministic order once the worker has finished.
+class recording_message_handlert:public message_handlert
+{
+public:
+  virtual void print(unsigned level, const std::string &message)
+  {
+    message_handlert::print(level, message);
+
+    if(verbosity>=level)
+      recorded+=std::to_string(level)+' '+
+                std::to_string(message.size())+'\n'+
+                message;
+  }
+
+  virtual void print(
+    unsigned level,
+    const std::string &message,
+    int sequence_number,
+    const source_locationt &location)
+  {
+    // renders the location as part of the text
+    message_handlert::print(level, message, sequence_number, location);
+  }
+
+  std::string recorded;
+
+  /// Passes messages recorded by print(), starting at \p pos in \p
+  /// recording, on to \p dest
+  static void replay(
+    const std::string &recording,
+    std::size_t pos,
+    message_handlert &dest);
+};
+
 class messaget
 {
 public:
@@ -23,7 +23,9 @@ Author:
 #else
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
 #include <cstring>
 #include <csignal>
 #endif
@@ -132,9 +134,15 @@ int pipe_streamt::run()
 {
   filedescriptor_streambuft::HANDLE in[2], out[2];
 
-  if(pipe(in)==-1 || pipe(out)==-1)
+  // the child reports a failing execvp through this pipe, which is closed
+  // without anything written by a successful one
+  int exec_status[2];
+
+  if(pipe(in)==-1 || pipe(out)==-1 || pipe(exec_status)==-1)
     return -1;
 
+  fcntl(exec_status[1], F_SETFD, FD_CLOEXEC);
+
   pid=fork();
 
   if(pid==0)
@@ -142,6 +150,7 @@ int pipe_streamt::run()
     // child
     close(in[1]);
     close(out[0]);
+    close(exec_status[0]);
     dup2(in[0], STDIN_FILENO);
     dup2(out[1], STDOUT_FILENO);
 
@@ -159,12 +168,14 @@ int pipe_streamt::run()
 
     _argv[args.size()+1]=nullptr;
 
-    int result=execvp(executable.c_str(), _argv.data());
-
-    if(result==-1)
-      perror(nullptr);
+    execvp(executable.c_str(), _argv.data());
 
-    return result;
+    // the child must not return into the caller's code
+    const int error=errno;
+    perror(nullptr);
+    const ssize_t written=::write(exec_status[1], &error, sizeof(error));
+    (void)written; // nothing else can be done if this fails
+    _exit(127);
   }
   else if(pid==-1)
   {
@@ -175,6 +186,26 @@ int pipe_streamt::run()
   // parent, mild cleanup
   close(in[0]);
   close(out[1]);
+  close(exec_status[1]);
+
+  int error;
+  ssize_t status_read;
+
+  do
+    status_read=::read(exec_status[0], &error, sizeof(error));
+  while(status_read==-1 && errno==EINTR);
+
+  close(exec_status[0]);
+
+  if(status_read>0)
+  {
+    // the executable could not be started
+    close(in[1]);
+    close(out[0]);
+    waitpid(pid, nullptr, 0);
+    pid=0;
+    return -1;
+  }
 
   // attach to streambuf
   buffer.set_in(in[1]);
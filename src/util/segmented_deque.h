@@ -0,0 +1,347 @@
+/*******************************************************************\
+
+Module: Double-Ended Queue with Stable Iterators
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Double-Ended Queue with Stable Iterators
+
+#ifndef CPROVER_UTIL_SEGMENTED_DEQUE_H
+#define CPROVER_UTIL_SEGMENTED_DEQUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "invariant.h"
+
+/// A sequence that grows at both ends and stores its elements in fixed-size
+/// chunks, which are never moved. Unlike std::deque, neither references nor
+/// iterators are invalidated by push_back() or push_front(): an iterator is
+/// the container together with the index of the element relative to the
+/// first element ever pushed to the back, which does not change when
+/// elements are added in front. Unlike std::list, there is no per-element
+/// allocation, and neighbouring elements share cache lines.
+/// Elements cannot be removed individually.
+template<typename T, std::size_t chunk_bits=8>
+class segmented_dequet
+{
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T value_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T &reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef const T &const_reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::size_t size_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename containert, typename valuet>
+  class iterator_templatet
+  {
+  public:
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef std::random_access_iterator_tag iterator_category;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef T value_type;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef std::ptrdiff_t difference_type;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef valuet *pointer;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef valuet &reference;
+
+    iterator_templatet():container(nullptr), index(0)
+    {
+    }
+
+    iterator_templatet(containert *_container, std::ptrdiff_t _index):
+      container(_container), index(_index)
+    {
+    }
+
+    // iterator to const_iterator
+    template<typename other_containert, typename other_valuet>
+    // NOLINTNEXTLINE(runtime/explicit)
+    iterator_templatet(
+      const iterator_templatet<other_containert, other_valuet> &other):
+      container(other.container), index(other.index)
+    {
+    }
+
+    reference operator*() const { return container->at_index(index); }
+    pointer operator->() const { return &container->at_index(index); }
+    reference operator[](difference_type n) const
+    {
+      return container->at_index(index+n);
+    }
+
+    iterator_templatet &operator++() { ++index; return *this; }
+    iterator_templatet &operator--() { --index; return *this; }
+    iterator_templatet operator++(int) { return {container, index++}; }
+    iterator_templatet operator--(int) { return {container, index--}; }
+
+    iterator_templatet &operator+=(difference_type n)
+    {
+      index+=n;
+      return *this;
+    }
+
+    iterator_templatet &operator-=(difference_type n)
+    {
+      index-=n;
+      return *this;
+    }
+
+    iterator_templatet operator+(difference_type n) const
+    {
+      return {container, index+n};
+    }
+
+    iterator_templatet operator-(difference_type n) const
+    {
+      return {container, index-n};
+    }
+
+    difference_type operator-(const iterator_templatet &other) const
+    {
+      return index-other.index;
+    }
+
+    // iterators into the same container are ordered by position
+    bool operator==(const iterator_templatet &other) const
+    {
+      return index==other.index && container==other.container;
+    }
+
+    bool operator!=(const iterator_templatet &other) const
+    {
+      return !(*this==other);
+    }
+
+    bool operator<(const iterator_templatet &other) const
+    {
+      return index<other.index;
+    }
+
+    bool operator>(const iterator_templatet &other) const
+    {
+      return other<*this;
+    }
+
+    bool operator<=(const iterator_templatet &other) const
+    {
+      return !(other<*this);
+    }
+
+    bool operator>=(const iterator_templatet &other) const
+    {
+      return !(*this<other);
+    }
+
+  protected:
+    template<typename, typename> friend class iterator_templatet;
+
+    containert *container;
+    std::ptrdiff_t index;
+  };
+
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef iterator_templatet<segmented_dequet, T> iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef iterator_templatet<const segmented_dequet, const T> const_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  segmented_dequet()
+  {
+  }
+
+  // the copy gets chunks of full capacity, which keeps references stable
+  segmented_dequet(const segmented_dequet &other)
+  {
+    for(const auto &element : other)
+      push_back(element);
+  }
+
+  segmented_dequet(segmented_dequet &&other):
+    front_chunks(std::move(other.front_chunks)),
+    back_chunks(std::move(other.back_chunks)),
+    front_size(other.front_size),
+    back_size(other.back_size)
+  {
+    other.clear();
+  }
+
+  segmented_dequet &operator=(const segmented_dequet &other)
+  {
+    if(&other!=this)
+    {
+      clear();
+      for(const auto &element : other)
+        push_back(element);
+    }
+
+    return *this;
+  }
+
+  segmented_dequet &operator=(segmented_dequet &&other)
+  {
+    if(&other!=this)
+    {
+      front_chunks=std::move(other.front_chunks);
+      back_chunks=std::move(other.back_chunks);
+      front_size=other.front_size;
+      back_size=other.back_size;
+      other.clear();
+    }
+
+    return *this;
+  }
+
+  iterator begin() { return {this, first_index()}; }
+  const_iterator begin() const { return {this, first_index()}; }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return {this, end_index()}; }
+  const_iterator end() const { return {this, end_index()}; }
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return front_size+back_size; }
+  bool empty() const { return size()==0; }
+
+  T &front() { return *begin(); }
+  const T &front() const { return *begin(); }
+  T &back() { return at_index(end_index()-1); }
+  const T &back() const { return at_index(end_index()-1); }
+
+  /// \param n: position relative to the first element
+  T &operator[](size_type n) { return begin()[n]; }
+  const T &operator[](size_type n) const { return begin()[n]; }
+
+  void push_back(const T &element)
+  {
+    chunk_for(back_chunks, back_size).push_back(element);
+    back_size++;
+  }
+
+  void push_back(T &&element)
+  {
+    chunk_for(back_chunks, back_size).push_back(std::move(element));
+    back_size++;
+  }
+
+  void push_front(const T &element)
+  {
+    chunk_for(front_chunks, front_size).push_back(element);
+    front_size++;
+  }
+
+  void push_front(T &&element)
+  {
+    chunk_for(front_chunks, front_size).push_back(std::move(element));
+    front_size++;
+  }
+
+  /// Moves the elements of \p other in front of the first element or
+  /// behind the last one, and leaves \p other empty. Other positions are
+  /// not supported, as the indices of the elements would change.
+  void splice(const_iterator position, segmented_dequet &other)
+  {
+    if(position==end())
+    {
+      for(auto &element : other)
+        push_back(std::move(element));
+    }
+    else
+    {
+      PRECONDITION(position==begin());
+
+      for(auto it=other.rbegin(); it!=other.rend(); it++)
+        push_front(std::move(*it));
+    }
+
+    other.clear();
+  }
+
+  void clear()
+  {
+    front_chunks.clear();
+    back_chunks.clear();
+    front_size=0;
+    back_size=0;
+  }
+
+protected:
+  typedef std::vector<T> chunkt;
+  static const std::size_t chunk_size=std::size_t(1)<<chunk_bits;
+
+  // The elements at indices 0, 1, ... are in the back chunks, the ones at
+  // indices -1, -2, ... are in the front chunks, each in that order. The
+  // capacity of each chunk is reserved when the chunk is created, hence
+  // the elements do not move when the chunk grows.
+  std::vector<chunkt> front_chunks, back_chunks;
+  std::size_t front_size=0, back_size=0;
+
+  std::ptrdiff_t first_index() const
+  {
+    return -static_cast<std::ptrdiff_t>(front_size);
+  }
+
+  std::ptrdiff_t end_index() const
+  {
+    return static_cast<std::ptrdiff_t>(back_size);
+  }
+
+  T &at_index(std::ptrdiff_t index)
+  {
+    if(index>=0)
+    {
+      const std::size_t i=index;
+      return back_chunks[i>>chunk_bits][i&(chunk_size-1)];
+    }
+
+    const std::size_t i=-(index+1);
+    return front_chunks[i>>chunk_bits][i&(chunk_size-1)];
+  }
+
+  const T &at_index(std::ptrdiff_t index) const
+  {
+    return const_cast<segmented_dequet &>(*this).at_index(index);
+  }
+
+  /// \return the chunk that the element after the first \p size elements
+  ///   in \p chunks goes into
+  static chunkt &chunk_for(std::vector<chunkt> &chunks, std::size_t size)
+  {
+    if((size&(chunk_size-1))==0)
+    {
+      chunks.emplace_back();
+      chunks.back().reserve(chunk_size);
+    }
+
+    return chunks.back();
+  }
+};
+
+#endif // CPROVER_UTIL_SEGMENTED_DEQUE_H
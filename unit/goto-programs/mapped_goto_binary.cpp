@@ -0,0 +1,137 @@
+/*******************************************************************\
+
+ Module: Unit tests for mapped_goto_binaryt
+
+ Author: Diffblue Limited. All rights reserved.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <fstream>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/mapped_goto_binary.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <util/arith_tools.h>
+#include <util/std_types.h>
+#include <util/tempfile.h>
+
+/// Adds a function \p name whose body is a loop that goes back to its
+/// first instruction
+static void add_loop_function(goto_modelt &goto_model, const irep_idt &name)
+{
+  code_typet type;
+  type.return_type()=empty_typet();
+
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.pretty_name=name;
+  symbol.mode=ID_C;
+  symbol.type=type;
+  goto_model.symbol_table.add(symbol);
+
+  goto_functionst::goto_functiont &function=
+    goto_model.goto_functions.function_map[name];
+  function.type=type;
+
+  goto_programt &body=function.body;
+  goto_programt::targett skip=body.add_instruction(SKIP);
+  goto_programt::targett loop=body.add_instruction(GOTO);
+  loop->targets.push_back(skip);
+  loop->guard=true_exprt();
+  body.add_instruction(END_FUNCTION);
+
+  for(auto &instruction : body.instructions)
+    instruction.function=name;
+
+  body.update();
+}
+
+SCENARIO(
+  "Functions are decoded from a mapped goto binary on demand",
+  "[core][goto-programs][mapped_goto_binary]")
+{
+  null_message_handlert message_handler;
+
+  GIVEN("A goto binary of version 4 with two functions")
+  {
+    goto_modelt goto_model;
+    add_loop_function(goto_model, "f");
+    add_loop_function(goto_model, "g");
+
+    temporary_filet binary("mapped_goto_binary", ".gb");
+    {
+      std::ofstream out(binary(), std::ios::binary);
+      REQUIRE_FALSE(write_goto_binary(out, goto_model, 4));
+    }
+
+    THEN("It has an index")
+    {
+      REQUIRE(mapped_goto_binaryt::has_index(binary()));
+    }
+
+    WHEN("It is mapped")
+    {
+      mapped_goto_binaryt mapped(message_handler);
+      REQUIRE_FALSE(mapped.open(binary()));
+
+      THEN("The index lists both functions")
+      {
+        REQUIRE(mapped.number_of_functions()==2);
+        REQUIRE(mapped.has_function("f"));
+        REQUIRE(mapped.has_function("g"));
+        REQUIRE_FALSE(mapped.has_function("h"));
+      }
+
+      THEN("A forgotten function is no longer in the index")
+      {
+        mapped.forget_function("f");
+        REQUIRE(mapped.number_of_functions()==1);
+        REQUIRE_FALSE(mapped.has_function("f"));
+        REQUIRE(mapped.has_function("g"));
+      }
+
+      THEN("The symbol table can be decoded")
+      {
+        symbol_tablet symbol_table;
+        mapped.read_symbol_table(symbol_table);
+        REQUIRE(symbol_table.has_symbol("f"));
+        REQUIRE(symbol_table.has_symbol("g"));
+      }
+
+      THEN("A function body can be decoded by itself")
+      {
+        goto_functionst::goto_functiont function;
+        mapped.read_function("g", function);
+
+        const goto_programt::instructionst &instructions=
+          function.body.instructions;
+        REQUIRE(instructions.size()==3);
+        REQUIRE(instructions.front().is_skip());
+        REQUIRE(instructions.front().function=="g");
+
+        const goto_programt::instructiont &loop=
+          *std::next(instructions.begin());
+        REQUIRE(loop.is_goto());
+        REQUIRE(loop.targets.size()==1);
+        REQUIRE(loop.targets.front()==instructions.begin());
+      }
+    }
+
+    THEN("It can be read eagerly, too")
+    {
+      goto_modelt read_model;
+      REQUIRE_FALSE(read_goto_binary(binary(), read_model, message_handler));
+      REQUIRE(
+        read_model.goto_functions.function_map.at("f").body.instructions.size()
+          ==3);
+      REQUIRE(
+        read_model.goto_functions.function_map.at("g").body.instructions.size()
+          ==3);
+    }
+  }
+}
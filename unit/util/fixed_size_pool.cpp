@@ -0,0 +1,50 @@
+/*******************************************************************\
+
+ Module: fixed_size_poolt tests
+
+ Author: Diffblue Limited. All rights reserved.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <util/fixed_size_pool.h>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+TEST_CASE("Allocate from and release to a fixed_size_poolt")
+{
+  fixed_size_poolt pool(24, 4);
+
+  REQUIRE(pool.block_size()>=24);
+  REQUIRE(pool.block_size()%alignof(std::max_align_t)==0);
+
+  std::vector<void *> blocks;
+  for(std::size_t i=0; i<10; i++)
+  {
+    void *p=pool.allocate();
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p)%alignof(std::max_align_t)==0);
+    std::memset(p, 0xff, 24);
+    blocks.push_back(p);
+  }
+
+  // all blocks are distinct
+  REQUIRE(std::set<void *>(blocks.begin(), blocks.end()).size()==10);
+  REQUIRE(pool.get_statistics().chunks==3);
+  REQUIRE(pool.get_statistics().live()==10);
+
+  for(void *p : blocks)
+    pool.deallocate(p);
+
+  REQUIRE(pool.get_statistics().live()==0);
+  REQUIRE(pool.get_statistics().peak_live==10);
+
+  // released blocks are re-used before any new chunk is allocated
+  for(std::size_t i=0; i<12; i++)
+    pool.allocate();
+  REQUIRE(pool.get_statistics().chunks==3);
+  pool.allocate();
+  REQUIRE(pool.get_statistics().chunks==4);
+}
@@ -0,0 +1,74 @@
+/*******************************************************************\
+
+ Module: irept sharing and hashing tests
+
+ Author: Diffblue Limited. All rights reserved.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <util/irep.h>
+#include <util/merge_irep.h>
+
+static irept make_tree(const irep_idt &leaf)
+{
+  irept tree("tree");
+  tree.get_sub().push_back(irept(leaf));
+  tree.set("name", "value");
+  return tree;
+}
+
+// Without HASH_CODE, hash() is recomputed on every call and there is no
+// cached hash that could go stale
+#ifdef HASH_CODE
+TEST_CASE("Hash of an irep follows changes to the irep")
+{
+  irept tree=make_tree("a");
+  const std::size_t hash_a=tree.hash();
+
+  SECTION("Change through the parent")
+  {
+    tree.get_sub()[0].id("b");
+    REQUIRE(tree==make_tree("b"));
+    REQUIRE(tree.hash()==make_tree("b").hash());
+    REQUIRE(tree.hash()!=hash_a);
+  }
+
+  SECTION("Change through a reference obtained before hashing")
+  {
+    irept &leaf=tree.get_sub()[0];
+    REQUIRE(tree.hash()==hash_a);
+    leaf.id("b");
+    REQUIRE(tree==make_tree("b"));
+    REQUIRE(tree.hash()==make_tree("b").hash());
+  }
+
+  SECTION("Copies are unaffected")
+  {
+    irept copy=tree;
+    tree.get_sub()[0].id("b");
+    REQUIRE(copy.hash()==hash_a);
+    REQUIRE(copy!=tree);
+  }
+}
+#endif
+
+TEST_CASE("Merged ireps share their nodes")
+{
+  merge_irept merge;
+
+  irept tree1=make_tree("a");
+  irept tree2=make_tree("a");
+  irept tree3=make_tree("b");
+  REQUIRE(&tree1.read()!=&tree2.read());
+
+  merge(tree1);
+  merge(tree2);
+  merge(tree3);
+
+  REQUIRE(&tree1.read()==&tree2.read());
+  REQUIRE(&tree1.get_sub()[0].read()==&tree2.get_sub()[0].read());
+  REQUIRE(tree1==tree2);
+  REQUIRE(tree1!=tree3);
+  REQUIRE(&tree1.find("name").read()==&tree3.find("name").read());
+}
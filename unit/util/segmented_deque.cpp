@@ -0,0 +1,116 @@
+/*******************************************************************\
+
+ Module: segmented_dequet tests
+
+ Author: Diffblue Limited. All rights reserved.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <util/segmented_deque.h>
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef segmented_dequet<std::string, 2> dequet;
+
+TEST_CASE("Grow a segmented_dequet at both ends")
+{
+  dequet deque;
+  std::list<std::string> list;
+
+  std::vector<dequet::iterator> iterators;
+  std::vector<const std::string *> addresses;
+
+  for(std::size_t i=0; i<20; i++)
+  {
+    const std::string value=std::to_string(i);
+
+    if(i%3==0)
+    {
+      deque.push_front(value);
+      list.push_front(value);
+      iterators.push_back(deque.begin());
+    }
+    else
+    {
+      deque.push_back(value);
+      list.push_back(value);
+      iterators.push_back(deque.end()-1);
+    }
+
+    addresses.push_back(&*iterators.back());
+  }
+
+  REQUIRE(deque.size()==list.size());
+  REQUIRE(std::equal(deque.begin(), deque.end(), list.begin()));
+  REQUIRE(std::equal(deque.rbegin(), deque.rend(), list.rbegin()));
+  REQUIRE(deque.front()==list.front());
+  REQUIRE(deque.back()==list.back());
+  REQUIRE(deque[3]==*std::next(list.begin(), 3));
+
+  // neither iterators nor references were invalidated by growing
+  for(std::size_t i=0; i<iterators.size(); i++)
+  {
+    REQUIRE(*iterators[i]==std::to_string(i));
+    REQUIRE(&*iterators[i]==addresses[i]);
+  }
+
+  // iterators are ordered by position
+  std::map<dequet::const_iterator, std::size_t> positions;
+  std::size_t position=0;
+  for(dequet::const_iterator it=deque.begin(); it!=deque.end(); it++)
+    positions[it]=position++;
+
+  std::size_t expected=0;
+  for(const auto &entry : positions)
+  {
+    REQUIRE(entry.first-deque.cbegin()==
+            static_cast<std::ptrdiff_t>(expected));
+    expected++;
+  }
+}
+
+TEST_CASE("Splice into a segmented_dequet")
+{
+  dequet deque, front, back;
+
+  deque.push_back("b");
+  const dequet::iterator b=deque.begin();
+
+  front.push_back("a1");
+  front.push_back("a2");
+  back.push_back("c");
+
+  deque.splice(deque.begin(), front);
+  deque.splice(deque.end(), back);
+
+  REQUIRE(front.empty());
+  REQUIRE(back.empty());
+  REQUIRE(
+    std::vector<std::string>(deque.begin(), deque.end())==
+    std::vector<std::string>({"a1", "a2", "b", "c"}));
+  REQUIRE(*b=="b");
+}
+
+TEST_CASE("Copy and move a segmented_dequet")
+{
+  dequet deque;
+  for(std::size_t i=0; i<10; i++)
+    deque.push_front(std::to_string(i));
+
+  dequet copy(deque);
+  REQUIRE(std::equal(copy.begin(), copy.end(), deque.begin()));
+
+  dequet moved(std::move(copy));
+  REQUIRE(copy.empty());
+  REQUIRE(copy.begin()==copy.end());
+  REQUIRE(std::equal(moved.begin(), moved.end(), deque.begin()));
+
+  // the copy keeps its references stable as it grows
+  const std::string *last=&moved.back();
+  moved.push_back("10");
+  REQUIRE(last==&*(moved.end()-2));
+}